@@ -0,0 +1,169 @@
+#pragma once
+
+#include "Common.h"
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace BOSS
+{
+
+// a set of action ids of one race, one bit per id
+// two 64 bit words cover Constants::MAX_ACTION_TYPES, so membership tests, unions and subset checks
+// are a couple of word operations and iterating the set only visits the bits that are set
+class ActionBitSet
+{
+    enum { NumWords = 2, WordBits = 64 };
+
+    unsigned long long  _words[NumWords];
+
+    static_assert(Constants::MAX_ACTION_TYPES <= NumWords * WordBits, "ActionBitSet is too small for MAX_ACTION_TYPES");
+
+    static const int trailingZeros(const unsigned long long & word)
+    {
+    #ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return (int)index;
+    #else
+        return __builtin_ctzll(word);
+    #endif
+    }
+
+    static const int popCount(const unsigned long long & word)
+    {
+    #ifdef _MSC_VER
+        return (int)__popcnt64(word);
+    #else
+        return __builtin_popcountll(word);
+    #endif
+    }
+
+public:
+
+    ActionBitSet()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        _words[0] = 0;
+        _words[1] = 0;
+    }
+
+    void add(const ActionID & id)
+    {
+        _words[id / WordBits] |= 1ull << (id % WordBits);
+    }
+
+    void remove(const ActionID & id)
+    {
+        _words[id / WordBits] &= ~(1ull << (id % WordBits));
+    }
+
+    const bool contains(const ActionID & id) const
+    {
+        return (_words[id / WordBits] >> (id % WordBits)) & 1;
+    }
+
+    // true if every id in set is also in this set
+    const bool containsAll(const ActionBitSet & set) const
+    {
+        return ((set._words[0] & ~_words[0]) | (set._words[1] & ~_words[1])) == 0;
+    }
+
+    const bool intersects(const ActionBitSet & set) const
+    {
+        return ((set._words[0] & _words[0]) | (set._words[1] & _words[1])) != 0;
+    }
+
+    const bool isEmpty() const
+    {
+        return (_words[0] | _words[1]) == 0;
+    }
+
+    const size_t size() const
+    {
+        return popCount(_words[0]) + popCount(_words[1]);
+    }
+
+    ActionBitSet & operator |= (const ActionBitSet & set)
+    {
+        _words[0] |= set._words[0];
+        _words[1] |= set._words[1];
+        return *this;
+    }
+
+    ActionBitSet & operator &= (const ActionBitSet & set)
+    {
+        _words[0] &= set._words[0];
+        _words[1] &= set._words[1];
+        return *this;
+    }
+
+    // removes every id in set from this set
+    ActionBitSet & operator -= (const ActionBitSet & set)
+    {
+        _words[0] &= ~set._words[0];
+        _words[1] &= ~set._words[1];
+        return *this;
+    }
+
+    const bool operator == (const ActionBitSet & set) const
+    {
+        return _words[0] == set._words[0] && _words[1] == set._words[1];
+    }
+
+    const bool operator != (const ActionBitSet & set) const
+    {
+        return !(*this == set);
+    }
+
+    // the index-th smallest id in the set, index must be less than size()
+    const size_t select(size_t index) const
+    {
+        size_t w(0);
+        const size_t lowCount(popCount(_words[0]));
+
+        if (index >= lowCount)
+        {
+            index -= lowCount;
+            w = 1;
+        }
+
+        // clear the lowest set bits until the one we want is the lowest
+        unsigned long long word = _words[w];
+        for (; index > 0; --index)
+        {
+            word &= word - 1;
+        }
+
+        return w * WordBits + trailingZeros(word);
+    }
+
+    // the smallest id in the set which is >= from, or MAX_ACTION_TYPES if there isn't one
+    // for (ActionID a(set.next(0)); a < Constants::MAX_ACTION_TYPES; a = set.next(a+1)) visits the set in id order
+    const size_t next(const size_t & from) const
+    {
+        for (size_t w(from / WordBits); w < NumWords; ++w)
+        {
+            unsigned long long word = _words[w];
+
+            if (w == from / WordBits)
+            {
+                word &= ~0ull << (from % WordBits);
+            }
+
+            if (word)
+            {
+                return w * WordBits + trailingZeros(word);
+            }
+        }
+
+        return Constants::MAX_ACTION_TYPES;
+    }
+};
+
+}
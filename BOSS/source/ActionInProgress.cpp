@@ -37,6 +37,31 @@ void ActionsInProgress::popNextAction()
     _inProgress.pop_back();
 }
 	
+// puts back an action taken by popNextAction, it must finish no later than every action in progress
+void ActionsInProgress::pushNextAction(const ActionInProgress & action)
+{
+	BOSS_ASSERT(_inProgress.size() == 0 || _inProgress[_inProgress.size()-1]._time >= action._time, "Action doesn't finish next");
+
+	_inProgress.push_back(action);
+	_numProgress[action._action.ID()]++;
+}
+
+// takes back an action added by addAction
+void ActionsInProgress::removeAction(const ActionType & action, FrameCountType time)
+{
+	for (size_t i(0); i < _inProgress.size(); ++i)
+	{
+		if (_inProgress[i]._action == action && _inProgress[i]._time == time)
+		{
+			_inProgress.removeByShift(i);
+			_numProgress[action.ID()]--;
+			return;
+		}
+	}
+
+	BOSS_ASSERT(false, "Action to remove is not in progress: %s", action.getName().c_str());
+}
+
 bool ActionsInProgress::isEmpty() const
 {
 	return _inProgress.size() == 0;
@@ -155,20 +180,18 @@ FrameCountType ActionsInProgress::whenActionsFinished(const PrerequisiteSet & ac
 	// the maximum of the (minimums for each action)
 	int totalMax = 0;
 	
-	// if there are actions still left
-	for (UnitCountType uc(0); uc < actions.size(); ++uc)
+	// for each action in the set
+	const ActionBitSet & actionIDs = actions.getActionIDs();
+	for (size_t id(actionIDs.next(0)); id < Constants::MAX_ACTION_TYPES; id = actionIDs.next(id + 1))
 	{	
-		// pop an action off the set
-		const ActionType & a = actions.getActionType(uc);
-			
 		// define a new minimum
 		int actionMin = std::numeric_limits<int>::max();
 		
 		// for each unit in our progress vector
 		for (size_t i(0); i<_inProgress.size(); ++i) 
 		{
-			// if the action matches
-			if (_inProgress[i]._action == a) 
+			// if the action matches, everything in progress is of the same race as the set
+			if (_inProgress[i]._action.ID() == id) 
 			{
 				// check to see if we have a new minimum
 				actionMin = (_inProgress[i]._time < actionMin) ? _inProgress[i]._time : actionMin;
@@ -55,6 +55,8 @@ public:
 	
 	void addAction(const ActionType & a, int time);
 	void popNextAction();
+	void pushNextAction(const ActionInProgress & action);
+	void removeAction(const ActionType & a, FrameCountType time);
 	bool isEmpty() const;
 	const UnitCountType size() const;
 
@@ -3,53 +3,64 @@
 using namespace BOSS;
 
 ActionSet::ActionSet()
+    : _race(Races::None)
 {
 
 }
 
 const size_t ActionSet::size() const
 {
-    return _actionTypes.size();
+    return _actionIDs.size();
 }
 
 const bool ActionSet::isEmpty() const
 {
-    return size() == 0;
+    return _actionIDs.isEmpty();
 }
 
-const ActionType & ActionSet::operator [] (const size_t & index) const
+const ActionBitSet & ActionSet::getActionIDs() const
 {
-    return _actionTypes[index];
+    return _actionIDs;
 }
 
-ActionType & ActionSet::operator [] (const size_t & index)
+ActionType ActionSet::operator [] (const size_t & index) const
 {
-    return _actionTypes[index];
+    BOSS_ASSERT(index < size(), "ActionSet index out of bounds, Size = %d, Index = %d", (int)size(), (int)index);
+
+    return ActionType(_race, (ActionID)_actionIDs.select(index));
 }
 
 const bool ActionSet::contains(const ActionType & action) const
 {
-    return _actionTypes.contains(action);
+    return (action.getRace() == _race) && _actionIDs.contains(action.ID());
 }
 
 void ActionSet::add(const ActionType & action)
 {
-    _actionTypes.push_back(action);
+    BOSS_ASSERT(isEmpty() || action.getRace() == _race, "Adding an action of a different race to an ActionSet");
+
+    _race = action.getRace();
+    _actionIDs.add(action.ID());
+}
+
+void ActionSet::addAllActions(const RaceID & race)
+{
+    const std::vector<ActionType> & allActions = ActionTypes::GetAllActionTypes(race);
+    for (size_t a(0); a < allActions.size(); ++a)
+    {
+        add(allActions[a]);
+    }
 }
 
 void ActionSet::remove(const ActionType & action)
 {
-    for (size_t i(0); i<_actionTypes.size(); ++i)
+    if (contains(action))
     {
-        if (_actionTypes[i] == action)
-        {
-            _actionTypes.removeByShift(i);
-            return;
-        }
+        _actionIDs.remove(action.ID());
     }
 }
 
 void ActionSet::clear()
 {
-    _actionTypes.clear();
-}
\ No newline at end of file
+    _actionIDs.clear();
+}
@@ -2,15 +2,18 @@
 
 #include "Common.h"
 #include "Constants.h"
-#include "Array.hpp"
+#include "ActionBitSet.hpp"
 #include "ActionType.h"
 
 namespace BOSS
 {
 
+// a set of action types of one race, stored as a bitset of their ids
+// the set is always in id order, so index i is the i-th smallest id in the set
 class ActionSet
 {
-	Vec<ActionType, Constants::MAX_ACTION_TYPES> _actionTypes;
+    ActionBitSet    _actionIDs;
+    RaceID          _race;
 
 public:
 
@@ -19,9 +22,9 @@ public:
     const size_t size() const;
     const bool isEmpty() const;
     const bool contains(const ActionType & type) const;
+    const ActionBitSet & getActionIDs() const;
 
-    const ActionType & operator [] (const size_t & index) const;
-    ActionType & operator [] (const size_t & index);
+    ActionType operator [] (const size_t & index) const;
 
     void add(const ActionType & action);
     void addAllActions(const RaceID & race);
@@ -29,4 +32,4 @@ public:
     void clear();
 };
 
-}
\ No newline at end of file
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common.h"
+#include "ActionTypeTable.h"
 
 namespace BOSS
 {
@@ -35,6 +36,8 @@ public:
 	ActionID                    whatBuildsAction()      const;	
 	const PrerequisiteSet &     getPrerequisites()      const;
     const PrerequisiteSet &     getRecursivePrerequisites()      const;
+    const ActionBitSet &        getPrerequisiteIDs()    const;
+    const ActionBitSet &        getRecursivePrerequisiteIDs()    const;
 	int                         getType()               const;
 	
 	const std::string &         getName()               const;
@@ -71,8 +74,52 @@ public:
     const bool operator == (const ActionType & rhs)     const;
     const bool operator != (const ActionType & rhs)     const;
     const bool operator <  (const ActionType & rhs)     const;
+
+private:
+
+    const ActionTypeTable::RaceTable & table()          const { return ActionTypeTable::Get(_race); }
+    bool                        hasFlag(const int flag) const { return (table().flags[_id] & flag) != 0; }
 };
 
+// the properties used by the search are read straight out of the packed ActionTypeTable
+inline const ActionID           ActionType::ID()                    const { return _id; }
+inline const RaceID             ActionType::getRace()               const { return _race; }
+
+inline ActionType               ActionType::whatBuildsActionType()  const { return ActionType(_race, table().whatBuilds[_id]); }
+inline ActionID                 ActionType::whatBuildsAction()      const { return table().whatBuilds[_id]; }
+inline ActionType               ActionType::requiredAddonType()     const { return ActionType(_race, table().requiredAddon[_id]); }
+inline const ActionBitSet &     ActionType::getPrerequisiteIDs()    const { return table().prerequisites[_id]; }
+inline const ActionBitSet &     ActionType::getRecursivePrerequisiteIDs() const { return table().recursivePrerequisites[_id]; }
+
+inline FrameCountType           ActionType::buildTime()             const { return table().buildTime[_id]; }
+inline ResourceCountType        ActionType::mineralPrice()          const { return table().mineralPrice[_id]; }
+inline ResourceCountType        ActionType::mineralPriceScaled()    const { return table().mineralPrice[_id] * 100; }
+inline ResourceCountType        ActionType::gasPrice()              const { return table().gasPrice[_id]; }
+inline ResourceCountType        ActionType::gasPriceScaled()        const { return table().gasPrice[_id] * 100; }
+inline SupplyCountType          ActionType::supplyRequired()        const { return table().supplyRequired[_id]; }
+inline SupplyCountType          ActionType::supplyProvided()        const { return table().supplyProvided[_id]; }
+inline UnitCountType            ActionType::numProduced()           const { return table().numProduced[_id]; }
+
+inline bool                     ActionType::isRefinery()            const { return hasFlag(ActionTypeTable::Refinery); }
+inline bool                     ActionType::isWorker()              const { return hasFlag(ActionTypeTable::Worker); }
+inline bool                     ActionType::isBuilding()            const { return hasFlag(ActionTypeTable::Building); }
+inline bool                     ActionType::isResourceDepot()       const { return hasFlag(ActionTypeTable::ResourceDepot); }
+inline bool                     ActionType::isSupplyProvider()      const { return hasFlag(ActionTypeTable::SupplyProvider); }
+inline bool                     ActionType::isUnit()                const { return hasFlag(ActionTypeTable::Unit); }
+inline bool                     ActionType::isTech()                const { return hasFlag(ActionTypeTable::Tech); }
+inline bool                     ActionType::isUpgrade()             const { return hasFlag(ActionTypeTable::Upgrade); }
+inline bool                     ActionType::whatBuildsIsBuilding()  const { return hasFlag(ActionTypeTable::WhatBuildsIsBuilding); }
+inline bool                     ActionType::whatBuildsIsLarva()     const { return hasFlag(ActionTypeTable::WhatBuildsIsLarva); }
+inline bool                     ActionType::canProduce()            const { return hasFlag(ActionTypeTable::CanProduce); }
+inline bool                     ActionType::canAttack()             const { return hasFlag(ActionTypeTable::CanAttack); }
+inline bool                     ActionType::isAddon()               const { return hasFlag(ActionTypeTable::Addon); }
+inline bool                     ActionType::requiresAddon()         const { return hasFlag(ActionTypeTable::RequiresAddon); }
+inline bool                     ActionType::isMorphed()             const { return hasFlag(ActionTypeTable::Morphed); }
+
+inline const bool ActionType::operator == (const ActionType & rhs)  const { return _race == rhs._race && _id == rhs._id; }
+inline const bool ActionType::operator != (const ActionType & rhs)  const { return _race != rhs._race || _id != rhs._id; }
+inline const bool ActionType::operator <  (const ActionType & rhs)  const { return _id < rhs._id; }
+
 class ActionSet;
 
 namespace ActionTypes
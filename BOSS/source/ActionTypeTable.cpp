@@ -0,0 +1,62 @@
+#include "ActionTypeTable.h"
+#include "ActionTypeData.h"
+
+using namespace BOSS;
+
+ActionTypeTable::RaceTable ActionTypeTable::Tables[Races::None + 1];
+
+void ActionTypeTable::Init()
+{
+    for (RaceID r(0); r < Races::NUM_RACES; ++r)
+    {
+        RaceTable & table = Tables[r];
+
+        BOSS_ASSERT(ActionTypeData::GetNumActionTypes(r) <= Constants::MAX_ACTION_TYPES, "Race %d has more than MAX_ACTION_TYPES actions", (int)r);
+
+        for (ActionID a(0); a < ActionTypeData::GetNumActionTypes(r); ++a)
+        {
+            const ActionTypeData & data = ActionTypeData::GetActionTypeData(r, a);
+
+            BOSS_ASSERT(data.buildTime() >= 0 && data.buildTime() <= std::numeric_limits<unsigned short>::max(), "Build time doesn't fit the action table: %s", data.getName().c_str());
+            BOSS_ASSERT(data.supplyRequired() >= 0 && data.supplyRequired() <= std::numeric_limits<unsigned char>::max(), "Supply doesn't fit the action table: %s", data.getName().c_str());
+            BOSS_ASSERT(data.supplyProvided() >= 0 && data.supplyProvided() <= std::numeric_limits<unsigned char>::max(), "Supply doesn't fit the action table: %s", data.getName().c_str());
+
+            table.mineralPrice[a]   = data.mineralPrice();
+            table.gasPrice[a]       = data.gasPrice();
+            table.buildTime[a]      = (unsigned short)data.buildTime();
+            table.supplyRequired[a] = (unsigned char)data.supplyRequired();
+            table.supplyProvided[a] = (unsigned char)data.supplyProvided();
+            table.numProduced[a]    = (unsigned char)data.numProduced();
+            table.whatBuilds[a]     = data.whatBuildsAction();
+            table.requiredAddon[a]  = data.requiredAddonID();
+
+            table.flags[a] = (data.isUnit()                 ? Unit                  : 0)
+                           | (data.isUpgrade()              ? Upgrade               : 0)
+                           | (data.isTech()                 ? Tech                  : 0)
+                           | (data.isBuilding()             ? Building              : 0)
+                           | (data.isWorker()               ? Worker                : 0)
+                           | (data.isRefinery()             ? Refinery              : 0)
+                           | (data.isResourceDepot()        ? ResourceDepot         : 0)
+                           | (data.isSupplyProvider()       ? SupplyProvider        : 0)
+                           | (data.canProduce()             ? CanProduce            : 0)
+                           | (data.canAttack()              ? CanAttack             : 0)
+                           | (data.whatBuildsIsBuilding()   ? WhatBuildsIsBuilding  : 0)
+                           | (data.whatBuildsIsLarva()      ? WhatBuildsIsLarva     : 0)
+                           | (data.isAddon()                ? Addon                 : 0)
+                           | (data.requiresAddon()          ? RequiresAddon         : 0)
+                           | (data.isMorphed()              ? Morphed               : 0);
+
+            const PrerequisiteSet & pre = data.getPrerequisites();
+            for (size_t p(0); p < pre.size(); ++p)
+            {
+                table.prerequisites[a].add(pre.getActionType(p).ID());
+            }
+
+            const PrerequisiteSet & recursivePre = data.getRecursivePrerequisites();
+            for (size_t p(0); p < recursivePre.size(); ++p)
+            {
+                table.recursivePrerequisites[a].add(recursivePre.getActionType(p).ID());
+            }
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Common.h"
+#include "ActionBitSet.hpp"
+
+namespace BOSS
+{
+
+// the numeric properties of every action type, packed per race into one array per property
+// ActionTypeData holds strings and BWAPI types, so reading a single price out of it touches a few
+// hundred bytes per action. the search only ever needs the numbers below, and these arrays keep
+// all of them for a race in a few kilobytes. built from ActionTypeData by BOSS::init()
+class ActionTypeTable
+{
+public:
+
+    enum Flags
+    {
+        Unit                    = 1 << 0,
+        Upgrade                 = 1 << 1,
+        Tech                    = 1 << 2,
+        Building                = 1 << 3,
+        Worker                  = 1 << 4,
+        Refinery                = 1 << 5,
+        ResourceDepot           = 1 << 6,
+        SupplyProvider          = 1 << 7,
+        CanProduce              = 1 << 8,
+        CanAttack               = 1 << 9,
+        WhatBuildsIsBuilding    = 1 << 10,
+        WhatBuildsIsLarva       = 1 << 11,
+        Addon                   = 1 << 12,
+        RequiresAddon           = 1 << 13,
+        Morphed                 = 1 << 14
+    };
+
+    struct RaceTable
+    {
+        ResourceCountType   mineralPrice[Constants::MAX_ACTION_TYPES];
+        ResourceCountType   gasPrice[Constants::MAX_ACTION_TYPES];
+        unsigned short      buildTime[Constants::MAX_ACTION_TYPES];
+        unsigned short      flags[Constants::MAX_ACTION_TYPES];
+        unsigned char       supplyRequired[Constants::MAX_ACTION_TYPES];
+        unsigned char       supplyProvided[Constants::MAX_ACTION_TYPES];
+        unsigned char       numProduced[Constants::MAX_ACTION_TYPES];
+        ActionID            whatBuilds[Constants::MAX_ACTION_TYPES];
+        ActionID            requiredAddon[Constants::MAX_ACTION_TYPES];
+
+        ActionBitSet        prerequisites[Constants::MAX_ACTION_TYPES];
+        ActionBitSet        recursivePrerequisites[Constants::MAX_ACTION_TYPES];
+    };
+
+private:
+
+    // one extra table for Races::None, which stays zeroed so ActionTypes::None reads as an empty action
+    static RaceTable    Tables[Races::None + 1];
+
+public:
+
+    static void Init();
+
+    static const RaceTable & Get(const RaceID race)
+    {
+        return Tables[race];
+    }
+};
+
+}
@@ -35,6 +35,25 @@ public:
         BOSS_ASSERT(size <= max_capacity,"Vec initializing with size > capacity, Size = %d, Capacity = %d",size,_capacity);
         fill(val);
     }
+
+    // copies only the elements in use, a default copy would copy the whole capacity
+    Vec<T,max_capacity>(const Vec<T,max_capacity> & rhs)
+        : _size(rhs._size)
+        ,_capacity(max_capacity)
+    {
+        std::copy(rhs._arr, rhs._arr + rhs._size, _arr);
+    }
+
+    Vec<T,max_capacity> & operator = (const Vec<T,max_capacity> & rhs)
+    {
+        if (this != &rhs)
+        {
+            _size = rhs._size;
+            std::copy(rhs._arr, rhs._arr + rhs._size, _arr);
+        }
+
+        return *this;
+    }
     
     void resize(const size_t & size)
     {
@@ -80,7 +99,7 @@ public:
     void addSorted(const T & e)
     {
         size_t index(0);
-        while (_arr[index] < e)
+        while (index < _size && _arr[index] < e)
         {
             ++index;
         }
@@ -100,7 +119,7 @@ public:
     void copyShiftRight(const size_t & index)
     {
         BOSS_ASSERT(_size < capacity(),"Array over capacity: Size = %d",capacity());
-        for (size_t i(_size + 1); i > index; --i)
+        for (size_t i(_size); i > index; --i)
         {
             _arr[i] = _arr[i-1];
         }
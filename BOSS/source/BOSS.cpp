@@ -5,7 +5,9 @@ namespace BOSS
     void init()
     {
         ActionTypeData::Init();
+        ActionTypeTable::Init();
         ActionTypes::init();
+        Hash::init();
     }
 
     void printData()
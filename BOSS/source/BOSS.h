@@ -15,6 +15,7 @@
 #include "BuildOrderSearchGoal.h"
 #include "BuildOrder.h"
 #include "NaiveBuildOrderSearch.h"
+#include "Hash.h"
 
 namespace BOSS
 {
@@ -80,6 +80,11 @@ UnitCountType BuildOrderSearchGoal::getGoalMax(const ActionType & a) const
     return _goalUnitsMax[a.ID()];
 }
 
+RaceID BuildOrderSearchGoal::getRace() const
+{
+    return _race;
+}
+
 SupplyCountType BuildOrderSearchGoal::supplyRequired() const
 {
     return _supplyRequiredVal;
@@ -30,6 +30,7 @@ public:
 	UnitCountType       operator [] (const ActionID & a) const;
 	UnitCountType       getGoal(const ActionType & a) const;
 	UnitCountType       getGoalMax(const ActionType & a) const;
+    RaceID              getRace() const;
 	
 	void                setGoal(const ActionType & a, const UnitCountType num);
 	void                setGoalMax(const ActionType & a, const UnitCountType num);
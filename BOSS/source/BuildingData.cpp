@@ -4,7 +4,7 @@ using namespace BOSS;
 
 BuildingStatus::BuildingStatus() 
 : _type(ActionTypes::None)
-, _timeRemaining(0) 
+, _freeFrame(0) 
 , _isConstructing(ActionTypes::None)
 , _addon(ActionTypes::None)
 {
@@ -13,15 +13,15 @@ BuildingStatus::BuildingStatus()
 	
 BuildingStatus::BuildingStatus(const ActionType & action, const ActionType & addon) 
 : _type(action)
-, _timeRemaining(0) 
+, _freeFrame(0) 
 , _isConstructing(ActionTypes::None)
 , _addon(addon)
 {
 }
 
-BuildingStatus::BuildingStatus(const ActionType & action, FrameCountType time, const ActionType & constructing, const ActionType & addon) 
+BuildingStatus::BuildingStatus(const ActionType & action, FrameCountType freeFrame, const ActionType & constructing, const ActionType & addon) 
 : _type(action)
-, _timeRemaining(time) 
+, _freeFrame(freeFrame) 
 , _isConstructing(constructing)
 , _addon(addon)
 {
@@ -44,7 +44,7 @@ const bool BuildingStatus::canBuildEventually(const ActionType & action) const
         }
 
         // if we are building an addon we can't ever build it
-        if (_timeRemaining > 0 && _isConstructing.isAddon())
+        if (_freeFrame > 0 && _isConstructing.isAddon())
         {
             return false;
         }
@@ -59,7 +59,7 @@ const bool BuildingStatus::canBuildEventually(const ActionType & action) const
     }
 
     // if the built type is morphed and we are morphing something, we won't be able to build it
-    if (action.isMorphed() && (_timeRemaining > 0) && (_isConstructing.isMorphed()))
+    if (action.isMorphed() && (_freeFrame > 0) && (_isConstructing.isMorphed()))
     {
         return false;
     }
@@ -69,7 +69,7 @@ const bool BuildingStatus::canBuildEventually(const ActionType & action) const
 
 const bool BuildingStatus::canBuildNow(const ActionType & action) const
 {
-    if (_timeRemaining > 0)
+    if (_freeFrame > 0)
     {
         return false;
     }
@@ -93,46 +93,47 @@ const bool BuildingStatus::canBuildNow(const ActionType & action) const
     return true;
 }
 
-void BuildingStatus::queueActionType(const ActionType & action)
+const FrameCountType BuildingStatus::getTimeUntilFree(const FrameCountType currentFrame) const
 {
-    _timeRemaining = action.buildTime();
-    _isConstructing = action;
+    return (_freeFrame > 0) ? _freeFrame - currentFrame : 0;
 }
 
-void BuildingStatus::fastForward(const FrameCountType frames)
+void BuildingStatus::queueActionType(const ActionType & action, const FrameCountType currentFrame)
 {
-    // if we fastforward more than the current time remaining, we will complete the action
-    bool willComplete = _timeRemaining <= frames;
-    int timeWasRemaining = _timeRemaining;
-    const std::string & name = _type.getName();
-
-    if ((_timeRemaining > 0) && willComplete)
-    {
-        BOSS_ASSERT(_isConstructing != ActionTypes::None, "We can't be building a unit without a type %s %d", _type.getName().c_str(), timeWasRemaining);
-
-        _timeRemaining = 0;
+    _freeFrame = currentFrame + action.buildTime();
+    _isConstructing = action;
+}
 
-        // if it's building an addon, add it
-        if (_isConstructing.isAddon())
-        {
-            _addon = _isConstructing;
-        }
+// called by BuildingData when the building's free event happens
+void BuildingStatus::finishConstructing()
+{
+    BOSS_ASSERT(_isConstructing != ActionTypes::None, "We can't be building a unit without a type %s", _type.getName().c_str());
 
-        // if we are finishing a morphed type, it becomes that type
-        if (_isConstructing.isMorphed())
-        {
-            _type = _isConstructing;
-        }
+    _freeFrame = 0;
 
-        _isConstructing = ActionTypes::None;
+    // if it's building an addon, add it
+    if (_isConstructing.isAddon())
+    {
+        _addon = _isConstructing;
     }
-    else if (_timeRemaining > 0)
+
+    // if we are finishing a morphed type, it becomes that type
+    if (_isConstructing.isMorphed())
     {
-        _timeRemaining -= frames;
+        _type = _isConstructing;
     }
+
+    _isConstructing = ActionTypes::None;
+}
+
+BuildingChange::BuildingChange(const UnitCountType index, const BuildingStatus & status)
+    : _index(index)
+    , _status(status)
+{
 }
 
 BuildingData::BuildingData() 
+    : _currentFrame(0)
 {
 }
 
@@ -157,16 +158,37 @@ void BuildingData::removeBuilding(const ActionType & action, const ActionType &
 		if (_buildings[i]._type == action)
 		{
 			_buildings.remove(i);
+
+            // removing swaps the last building into its place, so the events point at the wrong buildings
+            resetFreeEvents();
 			break;
 		}
 	}
 }
 
+void BuildingData::resetFreeEvents()
+{
+    _freeEvents.clear();
+
+    for (size_t i(0); i < _buildings.size(); ++i)
+    {
+        if (_buildings[i]._freeFrame > 0)
+        {
+            _freeEvents.push(_buildings[i]._freeFrame, (UnitCountType)i);
+        }
+    }
+}
+
 void BuildingData::addBuilding(const ActionType & action, const FrameCountType timeUntilFree, const ActionType & constructing, const ActionType & addon)
 {
 	BOSS_ASSERT(action.isBuilding(), "Trying to add a non-building to the building data");
+
+    if (timeUntilFree > 0)
+    {
+        _freeEvents.push(_currentFrame + timeUntilFree, (UnitCountType)_buildings.size());
+    }
 	
-    _buildings.push_back(BuildingStatus(action, timeUntilFree, constructing, addon));
+    _buildings.push_back(BuildingStatus(action, timeUntilFree > 0 ? _currentFrame + timeUntilFree : 0, constructing, addon));
 }
 
 const BuildingStatus & BuildingData::getBuilding(const UnitCountType i) const
@@ -174,6 +196,11 @@ const BuildingStatus & BuildingData::getBuilding(const UnitCountType i) const
 	return _buildings[i];
 }
 
+const FrameCountType BuildingData::getTimeUntilFree(const UnitCountType i) const
+{
+    return _buildings[i].getTimeUntilFree(_currentFrame);
+}
+
 // how long from now until we can build the given action
 const FrameCountType BuildingData::getTimeUntilCanBuild(const ActionType & action) const
 {
@@ -184,10 +211,18 @@ const FrameCountType BuildingData::getTimeUntilCanBuild(const ActionType & actio
 	{
         if (_buildings[i].canBuildEventually(action))
         {
-            if (!minset || _buildings[i]._timeRemaining < min)
+            const FrameCountType timeUntilFree = _buildings[i].getTimeUntilFree(_currentFrame);
+
+            if (!minset || timeUntilFree < min)
             {
                 minset = true;
-                min = _buildings[i]._timeRemaining;
+                min = timeUntilFree;
+            }
+
+            // nothing is free sooner than a building that's free now
+            if (min == 0)
+            {
+                break;
             }
         }
     }
@@ -197,13 +232,19 @@ const FrameCountType BuildingData::getTimeUntilCanBuild(const ActionType & actio
     return min;
 }
 
-void BuildingData::queueAction(const ActionType & action)
+void BuildingData::queueAction(const ActionType & action, std::vector<BuildingChange> * changes)
 {	
 	for (size_t i=0; i<_buildings.size(); ++i)
 	{
 		if (_buildings[i].canBuildNow(action))
 		{
-			_buildings[i].queueActionType(action);
+            if (changes)
+            {
+                changes->push_back(BuildingChange((UnitCountType)i, _buildings[i]));
+            }
+
+			_buildings[i].queueActionType(action, _currentFrame);
+            _freeEvents.push(_buildings[i]._freeFrame, (UnitCountType)i);
 			return;
 		}
 	}
@@ -212,13 +253,52 @@ void BuildingData::queueAction(const ActionType & action)
 	BOSS_ASSERT(false, "Didn't find a building to queue this type of unit in: %s", action.getName().c_str());
 }
 	
-// fast forward all the building states by amount: frames
-void BuildingData::fastForwardBuildings(const FrameCountType frames)
+// fast forward the buildings to toFrame, only the buildings which become free by then are touched
+void BuildingData::fastForwardBuildings(const FrameCountType toFrame, std::vector<BuildingChange> * changes)
 {
-	for (size_t i=0; i<_buildings.size(); ++i)
-	{
-        _buildings[i].fastForward(frames);
-	}
+    while (!_freeEvents.empty() && _freeEvents.nextFrame() <= toFrame)
+    {
+        if (changes)
+        {
+            changes->push_back(BuildingChange(_freeEvents.next(), _buildings[_freeEvents.next()]));
+        }
+
+        _buildings[_freeEvents.next()].finishConstructing();
+        _freeEvents.pop();
+    }
+
+    _currentFrame = toFrame;
+}
+
+// changes are undone last first, a building has a free event exactly while its free frame is set
+void BuildingData::undoChanges(const std::vector<BuildingChange> & changes, const size_t numBuildings, const FrameCountType frame)
+{
+    for (size_t c(changes.size()); c > 0; --c)
+    {
+        const BuildingChange & change = changes[c-1];
+        BuildingStatus & building = _buildings[change._index];
+
+        if (building._freeFrame > 0)
+        {
+            _freeEvents.remove(building._freeFrame, change._index);
+        }
+
+        building = change._status;
+
+        if (building._freeFrame > 0)
+        {
+            _freeEvents.push(building._freeFrame, change._index);
+        }
+    }
+
+    BOSS_ASSERT(numBuildings <= _buildings.size(), "Can't undo to more buildings than there are");
+    _buildings.resize(numBuildings);
+    _currentFrame = frame;
+}
+
+const FrameCountType BuildingData::getCurrentFrame() const
+{
+    return _currentFrame;
 }
 
 std::string BuildingData::toString() const
@@ -230,7 +310,7 @@ std::string BuildingData::toString() const
 	{
         const BuildingStatus & b = _buildings[i];
         ss << b._type.getName() << "   "; 
-        ss << b._timeRemaining << "   "; 
+        ss << b.getTimeUntilFree(_currentFrame) << "   "; 
         ss << (b._isConstructing != ActionTypes::None ? b._isConstructing.getName() : "None") << "   ";
         ss << (b._addon != ActionTypes::None ? b._addon.getName() : "None") << "\n";
     }
@@ -268,13 +348,13 @@ void BuildingData::printBuildingInformation() const
 {
 	for (size_t i=0; i<_buildings.size(); ++i)
 	{
-		if (_buildings[i]._timeRemaining == 0) 
+		if (_buildings[i]._freeFrame == 0) 
 		{
 			printf("BUILDING INFO: %s is free to assign\n", _buildings[i]._type.getName().c_str());
 		}
 		else 
 		{
-			printf("BUILDING INFO: %s will be free in %d frames\n", _buildings[i]._type.getName().c_str(), _buildings[i]._timeRemaining);
+			printf("BUILDING INFO: %s will be free in %d frames\n", _buildings[i]._type.getName().c_str(), _buildings[i].getTimeUntilFree(_currentFrame));
 		}
 	}
 		
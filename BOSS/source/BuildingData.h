@@ -9,6 +9,7 @@
 #include "PrerequisiteSet.h"
 #include "Array.hpp"
 #include "ActionType.h"
+#include "EventQueue.hpp"
 
 namespace BOSS
 {
@@ -19,29 +20,42 @@ class BuildingStatus
 public:
 
 	ActionType _type;               // the type of building this is
-    FrameCountType _timeRemaining;  // amount of time until the unit is finished constructing
+    FrameCountType _freeFrame;      // the frame the building will be free on, 0 if it is free now
     ActionType _isConstructing;     // the type of unit the building is currently constructing
     ActionType _addon;              // the type of addon that the building currently has (is set once completed)
 	
-	// the number of frames remaining (from currentFrame) until this building is free
-	
-
 	BuildingStatus();
 	
 	BuildingStatus(const ActionType & t, const ActionType & addon);
-	BuildingStatus(const ActionType & t, FrameCountType time, const ActionType & constructing, const ActionType & addon);
+	BuildingStatus(const ActionType & t, FrameCountType freeFrame, const ActionType & constructing, const ActionType & addon);
 
     const bool canBuildNow(const ActionType & action) const;
     const bool canBuildEventually(const ActionType & action) const;
-    void queueActionType(const ActionType & action);
-    void fastForward(const FrameCountType frames);
+    const FrameCountType getTimeUntilFree(const FrameCountType currentFrame) const;
+    void queueActionType(const ActionType & action, const FrameCountType currentFrame);
+    void finishConstructing();
 
     const std::string toString() const;
 };
 
+// a building's status before doing an action changed it, kept so BuildingData::undoChanges can put it back
+class BuildingChange
+{
+public:
+
+    UnitCountType   _index;
+    BuildingStatus  _status;
+
+    BuildingChange(const UnitCountType index, const BuildingStatus & status);
+};
+
 class BuildingData
 {
-	Vec<BuildingStatus, Constants::MAX_BUILDINGS> _buildings;
+	Vec<BuildingStatus, Constants::MAX_BUILDINGS>       _buildings;
+    EventQueue<UnitCountType, Constants::MAX_BUILDINGS> _freeEvents;    // when each busy building becomes free, by index into _buildings
+    FrameCountType                                      _currentFrame;
+
+    void resetFreeEvents();
 
 public:
 
@@ -52,12 +66,17 @@ public:
 	void addBuilding(const ActionType & action, const FrameCountType timeUntilFree, const ActionType & constructing, const ActionType & addon);
 
 	const BuildingStatus & getBuilding(const UnitCountType i) const;
+    const FrameCountType getTimeUntilFree(const UnitCountType i) const;
 	
     const FrameCountType getTimeUntilCanBuild(const ActionType & action) const;
 
-	// queue an action
-	void queueAction(const ActionType & action);
-	void fastForwardBuildings(const FrameCountType frames);
+	// queue an action, changes records the building's status before it if given
+	void queueAction(const ActionType & action, std::vector<BuildingChange> * changes = nullptr);
+	void fastForwardBuildings(const FrameCountType toFrame, std::vector<BuildingChange> * changes = nullptr);
+
+    // puts back the statuses in changes, then removes buildings past numBuildings and goes back to frame
+    void undoChanges(const std::vector<BuildingChange> & changes, const size_t numBuildings, const FrameCountType frame);
+    const FrameCountType getCurrentFrame() const;
 	void printBuildingInformation() const;
     const size_t & size() const;
 
@@ -12,7 +12,10 @@ DFBB_BuildOrderSearchParameters::DFBB_BuildOrderSearchParameters(const RaceID &
     , supplyBoundingThreshold(1)
     , useLandmarkLowerBoundHeuristic(true)
     , useResourceLowerBoundHeuristic(true)
+    , useTranspositionTable(true)
+    , transpositionTableSize(1 << 18)
     , searchTimeLimit(0)
+    , numThreads(1)
     , initialUpperBound(0)
     , repetitionValues(Constants::MAX_ACTIONS, 1)
     , repetitionThresholds(Constants::MAX_ACTIONS, 0)
@@ -67,6 +70,11 @@ std::string DFBB_BuildOrderSearchParameters::toString() const
     ss << (useResourceLowerBoundHeuristic ?    "\tUSE      Resource Lower Bound\n" : "");
     ss << (useAlwaysMakeWorkers ?              "\tUSE      Always Make Workers\n" : "");
     ss << (useSupplyBounding ?                 "\tUSE      Supply Bounding\n" : "");
+    ss << (useTranspositionTable ?             "\tUSE      Transposition Table\n" : "");
+    if (numThreads > 1)
+    {
+        ss << "\tUSE      " << numThreads << " Threads\n";
+    }
     ss << ("\n");
 
     for (ActionID a(0); a < repetitionValues.size(); ++a)
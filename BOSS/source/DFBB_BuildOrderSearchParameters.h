@@ -71,6 +71,19 @@ public:
     bool useLandmarkLowerBoundHeuristic;
     bool useResourceLowerBoundHeuristic;
 
+    //      Flag which determines whether or not we use a transposition table in our search
+    //      Different action orderings frequently reach the same set of units, buildings and
+    //          actions in progress. The table remembers the earliest frame and the most resources
+    //          seen for each such state; a state which is reached no earlier and with no more
+    //          minerals or gas than a stored one is dominated and its subtree is not searched.
+    //          transpositionTableSize is the most entries the table grows to as the search stores
+    //          states, and is rounded up to a power of 2.
+    //
+    //      true:  the transposition table is used
+    //      false: the transposition table is not used
+    bool useTranspositionTable;
+    size_t transpositionTableSize;
+
     //      Search time limit measured in milliseconds
     //      If searchTimeLimit is set to a value greater than zero, the search will effectively
     //          time out and the best solution so far will be used in the results. This is
@@ -78,6 +91,15 @@ public:
     //          once every 1000 nodes expanded, as checking the time is slow.
     double searchTimeLimit;
 
+    //      Number of threads the search is split between
+    //      With more than one thread the search tree is divided into subtrees which are searched
+    //          in parallel. Threads which run out of work take unsearched children from the top of
+    //          another thread's stack, and the best solution found by any thread bounds all of them.
+    //          Each thread keeps its own transposition table of transpositionTableSize entries.
+    //          The search returns the same makespan as with one thread, but may return a
+    //          different build order when several build orders share the optimal makespan.
+    size_t numThreads;
+
     //      Initial upper bound for the DFBB search
     //      If this value is set to zero, DFBB search will automatically determine an
     //          appropriate upper bound using an upper bound heuristic. If it is non-zero,
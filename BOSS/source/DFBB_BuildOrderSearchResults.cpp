@@ -8,6 +8,7 @@ DFBB_BuildOrderSearchResults::DFBB_BuildOrderSearchResults()
     , solutionFound(false)
     , upperBound(0)
     , nodesExpanded(0)
+    , nodesDominated(0)
     , timeElapsed(0)
 {
 }
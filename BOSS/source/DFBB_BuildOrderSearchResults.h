@@ -21,6 +21,7 @@ public:
 	int					        upperBound;		// upper bound of first node
 	
 	unsigned long long 	        nodesExpanded;	// number of nodes expanded in the search
+	unsigned long long 	        nodesDominated;	// number of children cut by the transposition table
 	
 	double 				        timeElapsed;	// time elapsed in milliseconds
 
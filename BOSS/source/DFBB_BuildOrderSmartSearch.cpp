@@ -8,6 +8,7 @@ DFBB_BuildOrderSmartSearch::DFBB_BuildOrderSmartSearch(const RaceID race)
     , _goal(race)
     , _stackSearch(race)
     , _searchTimeLimit(30)
+    , _numThreads(1)
 {
 }
 
@@ -33,6 +34,7 @@ void DFBB_BuildOrderSmartSearch::doSearch()
         _params.supplyBoundingThreshold     = 1.5;
         _params.relevantActions             = _relevantActions;
         _params.searchTimeLimit             = _searchTimeLimit;
+        _params.numThreads                  = _numThreads;
 
         //BWAPI::Broodwar->printf("Constructing new search object time limit is %lf", _params.searchTimeLimit);
         _stackSearch = DFBB_BuildOrderStackSearch(_params);
@@ -307,6 +309,11 @@ void DFBB_BuildOrderSmartSearch::setTimeLimit(int n)
     _searchTimeLimit = n;
 }
 
+void DFBB_BuildOrderSmartSearch::setNumThreads(const size_t n)
+{
+    _numThreads = n;
+}
+
 void DFBB_BuildOrderSmartSearch::search()
 {
     doSearch();
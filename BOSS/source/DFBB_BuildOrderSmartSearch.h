@@ -19,6 +19,7 @@ class DFBB_BuildOrderSmartSearch
 	GameState					        _initialState;
 	
 	int 							    _searchTimeLimit;
+    size_t                              _numThreads;
 
 	Timer							    _searchTimer;
 
@@ -47,6 +48,7 @@ public:
 	void setState(const GameState & state);
 	void print();
 	void setTimeLimit(int n);
+    void setNumThreads(const size_t n);
 	
 	void search();
 
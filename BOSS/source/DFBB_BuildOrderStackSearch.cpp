@@ -1,4 +1,5 @@
 #include "DFBB_BuildOrderStackSearch.h"
+#include <thread>
 
 using namespace BOSS;
 
@@ -8,6 +9,10 @@ DFBB_BuildOrderStackSearch::DFBB_BuildOrderStackSearch(const DFBB_BuildOrderSear
     , _firstSearch(true)
     , _wasInterrupted(false)
     , _stack(100, StackData())
+    , _workerIndex(0)
+    , _workInProgress(false)
+    , _rootActionGiven(false)
+    , _lowerBound(p.goal, p.useLandmarkLowerBoundHeuristic, p.useResourceLowerBoundHeuristic)
 {
     
 }
@@ -31,25 +36,40 @@ void DFBB_BuildOrderStackSearch::search()
             // add one frame to the upper bound so our strictly lesser than check still works if we have an exact upper bound
             _results.upperBound += 1;
 
-            _stack[0].state = _params.initialState;
+            // the search only needs the build order, so don't have the state keep its own list of actions
+            _state = _params.initialState;
+            _state.setTrackActionsPerformed(false);
+
+            if (_params.useTranspositionTable && _params.numThreads <= 1)
+            {
+                _transpositionTable.resize(_params.transpositionTableSize);
+            }
+
             _firstSearch = false;
             //BWAPI::Broodwar->printf("Upper bound is %d", _results.upperBound);
             std::cout << "Upper bound is: " << _results.upperBound << std::endl;
         }
 
-        try 
+        if (_params.numThreads > 1)
         {
-            // search on the initial state
-            DFBB();
-
-            _results.timedOut = false;
+            parallelSearch();
         }
-        catch (int e) 
+        else
         {
-            if (e == DFBB_TIMEOUT_EXCEPTION)
+            try 
             {
-                //BWAPI::Broodwar->printf("I timed out!");
-                _results.timedOut = true;
+                // search on the initial state
+                DFBB();
+
+                _results.timedOut = false;
+            }
+            catch (int e) 
+            {
+                if (e == DFBB_TIMEOUT_EXCEPTION)
+                {
+                    //BWAPI::Broodwar->printf("I timed out!");
+                    _results.timedOut = true;
+                }
             }
         }
         
@@ -59,6 +79,192 @@ void DFBB_BuildOrderStackSearch::search()
     }
 }
 
+// splits the search between _params.numThreads workers which each run DFBB on the subtrees they are given
+// the whole tree starts as a single work item, and a busy worker gives away the shallowest unsearched child
+// on its stack whenever another worker is idle. the workers and their unfinished work are kept when the
+// search times out, so the next call to search() carries on where this one stopped
+void DFBB_BuildOrderStackSearch::parallelSearch()
+{
+    if (!_parallel)
+    {
+        _parallel = std::shared_ptr<DFBB_ParallelSearchData>(new DFBB_ParallelSearchData(_params.numThreads, _results.upperBound));
+        _parallel->addWork(0, DFBB_WorkItem());
+
+        for (size_t w(0); w < _params.numThreads; ++w)
+        {
+            std::shared_ptr<DFBB_BuildOrderStackSearch> worker(new DFBB_BuildOrderStackSearch(_params));
+            worker->_parallel = _parallel;
+            worker->_workerIndex = w;
+            worker->_firstSearch = false;
+            worker->_results.upperBound = _results.upperBound;
+
+            if (_params.useTranspositionTable)
+            {
+                worker->_transpositionTable.resize(_params.transpositionTableSize);
+            }
+
+            _workers.push_back(worker);
+        }
+    }
+
+    _parallel->stop = false;
+    _parallel->idleWorkers = 0;
+
+    for (size_t w(0); w < _workers.size(); ++w)
+    {
+        _workers[w]->_params.searchTimeLimit = _params.searchTimeLimit;
+    }
+
+    // an exception can't leave its thread, so one thrown by a worker is rethrown here once every thread is done
+    std::vector<std::exception_ptr> exceptions(_workers.size());
+    auto runWorker = [this, &exceptions](const size_t w)
+    {
+        try
+        {
+            _workers[w]->workerSearch();
+        }
+        catch (...)
+        {
+            exceptions[w] = std::current_exception();
+            _parallel->stop = true;
+        }
+    };
+
+    // this thread runs the first worker itself
+    std::vector<std::thread> threads;
+    for (size_t w(1); w < _workers.size(); ++w)
+    {
+        threads.push_back(std::thread(runWorker, w));
+    }
+
+    runWorker(0);
+
+    for (size_t t(0); t < threads.size(); ++t)
+    {
+        threads[t].join();
+    }
+
+    const DFBB_BuildOrderSearchResults & best = _parallel->getResults();
+    _results.upperBound     = best.upperBound;
+    _results.solutionFound  = best.solutionFound;
+    _results.buildOrder     = best.buildOrder;
+    _results.finalState     = best.finalState;
+    _results.timedOut       = _parallel->stop;
+
+    _results.nodesExpanded  = 0;
+    _results.nodesDominated = 0;
+    for (size_t w(0); w < _workers.size(); ++w)
+    {
+        _results.nodesExpanded  += _workers[w]->_results.nodesExpanded;
+        _results.nodesDominated += _workers[w]->_results.nodesDominated;
+    }
+
+    for (size_t w(0); w < exceptions.size(); ++w)
+    {
+        if (exceptions[w])
+        {
+            std::rethrow_exception(exceptions[w]);
+        }
+    }
+}
+
+// what each thread of a parallel search runs: finish the work item on the stack, then get another one
+void DFBB_BuildOrderStackSearch::workerSearch()
+{
+    _searchTimer.start();
+
+    try
+    {
+        while (!_parallel->stop)
+        {
+            if (!_workInProgress)
+            {
+                DFBB_WorkItem item;
+                if (!_parallel->getWork(_workerIndex, item))
+                {
+                    return;
+                }
+
+                startWorkItem(item);
+            }
+
+            DFBB();
+            _workInProgress = false;
+        }
+    }
+    catch (int e)
+    {
+        // the stack is left as it was so the next search resumes it, and the other workers stop at their next node
+        if (e == DFBB_TIMEOUT_EXCEPTION)
+        {
+            _parallel->stop = true;
+        }
+    }
+}
+
+void DFBB_BuildOrderStackSearch::startWorkItem(const DFBB_WorkItem & item)
+{
+    _state = _params.initialState;
+    _state.setTrackActionsPerformed(false);
+
+    _buildOrder = item.prefix;
+    for (size_t i(0); i < _buildOrder.size(); ++i)
+    {
+        _state.doAction(_buildOrder[i]);
+    }
+
+    _depth = 0;
+    _stack[0].legalActions.clear();
+    _rootActionGiven = item.action != ActionTypes::None;
+    if (_rootActionGiven)
+    {
+        _stack[0].legalActions.add(item.action);
+    }
+
+    _workInProgress = true;
+}
+
+// gives the shallowest child on the stack which hasn't been searched yet to an idle worker
+// children near the root have the largest subtrees, so a few splits keep every worker busy
+void DFBB_BuildOrderStackSearch::splitWork()
+{
+    // the last item this worker gave away hasn't been taken yet
+    if (_parallel->hasWork(_workerIndex))
+    {
+        return;
+    }
+
+    // the build order holds the work item's prefix followed by each depth's current child
+    size_t prefixSize = _buildOrder.size();
+    for (size_t d(0); d < _depth; ++d)
+    {
+        prefixSize -= _stack[d].completedRepetitions;
+    }
+
+    for (size_t d(0); d < _depth; ++d)
+    {
+        StackData & stackData = _stack[d];
+
+        if (stackData.currentChildIndex + 1 < stackData.legalActions.size())
+        {
+            DFBB_WorkItem item;
+            for (size_t i(0); i < prefixSize; ++i)
+            {
+                item.prefix.add(_buildOrder[i]);
+            }
+
+            // removing the last child doesn't move the index of the one being searched
+            item.action = stackData.legalActions[stackData.legalActions.size() - 1];
+            stackData.legalActions.remove(item.action);
+
+            _parallel->addWork(_workerIndex, item);
+            return;
+        }
+
+        prefixSize += stackData.completedRepetitions;
+    }
+}
+
 const DFBB_BuildOrderSearchResults & DFBB_BuildOrderStackSearch::getResults() const
 {
     return _results;
@@ -74,7 +280,6 @@ void DFBB_BuildOrderStackSearch::generateLegalActions(const GameState & state, A
     for (size_t a(0); a < _params.relevantActions.size(); ++a)
     {
         const ActionType & actionType = _params.relevantActions[a];
-        const std::string & actionName = actionType.getName();
         const size_t numTotal = state.getUnitData().getNumTotal(actionType);
 
         if (state.isLegal(actionType))
@@ -174,6 +379,12 @@ UnitCountType DFBB_BuildOrderStackSearch::getRepetitions(const GameState & state
 
 bool DFBB_BuildOrderStackSearch::isTimeOut()
 {
+    // a worker of a parallel search also stops as soon as any other worker times out
+    if (_parallel && _parallel->stop)
+    {
+        return true;
+    }
+
     return (_params.searchTimeLimit && (_results.nodesExpanded % 200 == 0) && (_searchTimer.getElapsedTimeInMilliSec() > _params.searchTimeLimit));
 }
 
@@ -187,6 +398,14 @@ void DFBB_BuildOrderStackSearch::updateResults(const GameState & state)
         _results.timeElapsed = _searchTimer.getElapsedTimeInMilliSec();
         _results.upperBound = finishTime;
         _results.solutionFound = true;
+
+        // a worker's solution only counts if no other worker has found a better one in the meantime
+        if (_parallel)
+        {
+            _parallel->offerSolution(_buildOrder, state, _results.timeElapsed);
+            return;
+        }
+
         _results.finalState = state;
         _results.buildOrder = _buildOrder;
 
@@ -195,12 +414,13 @@ void DFBB_BuildOrderStackSearch::updateResults(const GameState & state)
 }
 
 #define ACTION_TYPE     _stack[_depth].currentActionType
-#define STATE           _stack[_depth].state
-#define CHILD_STATE     _stack[_depth+1].state
+#define STATE           _state
+#define UNDO            _stack[_depth].undo
 #define CHILD_NUM       _stack[_depth].currentChildIndex
 #define LEGAL_ACTINS    _stack[_depth].legalActions
 #define REPETITIONS     _stack[_depth].repetitionValue
 #define COMPLETED_REPS  _stack[_depth].completedRepetitions
+#define LOWER_BOUND     _stack[_depth].lowerBound
 
 #define DFBB_CALL_RETURN  if (_depth == 0) { return; } else { --_depth; goto SEARCH_RETURN; }
 #define DFBB_CALL_RECURSE { ++_depth; goto SEARCH_BEGIN; }
@@ -209,7 +429,6 @@ void DFBB_BuildOrderStackSearch::updateResults(const GameState & state)
 void DFBB_BuildOrderStackSearch::DFBB()
 {
     FrameCountType actionFinishTime = 0;
-    FrameCountType heuristicTime = 0;
     FrameCountType maxHeuristic = 0;
 
 SEARCH_BEGIN:
@@ -221,14 +440,34 @@ SEARCH_BEGIN:
         throw DFBB_TIMEOUT_EXCEPTION;
     }
 
-    generateLegalActions(STATE, LEGAL_ACTINS);
+    if (_parallel)
+    {
+        // prune against the best solution any worker has found
+        _results.upperBound = _parallel->upperBound;
+
+        if (_parallel->idleWorkers > 0)
+        {
+            splitWork();
+        }
+    }
+
+    // the lower bound only depends on this state, so every child shares it
+    LOWER_BOUND = STATE.getCurrentFrame() + _lowerBound.getLowerBound(STATE);
+    if (LOWER_BOUND > _results.upperBound)
+    {
+        DFBB_CALL_RETURN;
+    }
+
+    if (_depth > 0 || !_rootActionGiven)
+    {
+        generateLegalActions(STATE, LEGAL_ACTINS);
+    }
     for (CHILD_NUM = 0; CHILD_NUM < LEGAL_ACTINS.size(); ++CHILD_NUM)
     {
         ACTION_TYPE = LEGAL_ACTINS[CHILD_NUM];
 
         actionFinishTime = STATE.whenCanPerform(ACTION_TYPE) + ACTION_TYPE.buildTime();
-        heuristicTime    = STATE.getCurrentFrame() + Tools::GetLowerBound(STATE, _params.goal);
-        maxHeuristic     = (actionFinishTime > heuristicTime) ? actionFinishTime : heuristicTime;
+        maxHeuristic     = (actionFinishTime > LOWER_BOUND) ? actionFinishTime : LOWER_BOUND;
 
         if (maxHeuristic > _results.upperBound)
         {
@@ -238,15 +477,16 @@ SEARCH_BEGIN:
         REPETITIONS = getRepetitions(STATE, ACTION_TYPE);
         BOSS_ASSERT(REPETITIONS > 0, "Can't have zero repetitions!");
                 
-        // do the action as many times as legal to to 'repeat'
-        CHILD_STATE = STATE;
+        // do the action as many times as legal to to 'repeat', the child is undone when we return to this depth
+        // a timeout throws without undoing, so the next search() resumes from the state it stopped at
+        STATE.saveUndo(UNDO);
         COMPLETED_REPS = 0;
         for (; COMPLETED_REPS < REPETITIONS; ++COMPLETED_REPS)
         {
-            if (CHILD_STATE.isLegal(ACTION_TYPE))
+            if (STATE.isLegal(ACTION_TYPE))
             {
                 _buildOrder.add(ACTION_TYPE);
-                CHILD_STATE.doAction(ACTION_TYPE);
+                STATE.doAction(ACTION_TYPE, &UNDO);
             }
             else
             {
@@ -254,9 +494,13 @@ SEARCH_BEGIN:
             }
         }
 
-        if (_params.goal.isAchievedBy(CHILD_STATE))
+        if (_params.goal.isAchievedBy(STATE))
         {
-            updateResults(CHILD_STATE);
+            updateResults(STATE);
+        }
+        else if (_params.useTranspositionTable && _transpositionTable.isDominated(STATE))
+        {
+            _results.nodesDominated++;
         }
         else
         {
@@ -269,6 +513,8 @@ SEARCH_RETURN:
         {
             _buildOrder.pop_back();
         }
+
+        STATE.undo(UNDO);
     }
 
     DFBB_CALL_RETURN;
@@ -7,6 +7,9 @@
 #include "Timer.hpp"
 #include "Tools.h"
 #include "BuildOrder.h"
+#include "DFBB_TranspositionTable.h"
+#include "DFBB_ParallelSearchData.h"
+#include "DFBB_LowerBound.h"
 
 #define DFBB_TIMEOUT_EXCEPTION 1
 
@@ -18,16 +21,18 @@ class StackData
 public:
 
     size_t              currentChildIndex;
-    GameState           state;
+    GameStateUndo       undo;                   // the state before this depth's current child was done
     ActionSet           legalActions;
     ActionType          currentActionType;
     UnitCountType       repetitionValue;
     UnitCountType       completedRepetitions;
+    FrameCountType      lowerBound;             // the earliest frame the goal can be finished from this depth's state
     
     StackData()
         : currentChildIndex(0)
         , repetitionValue(1)
         , completedRepetitions(0)
+        , lowerBound(0)
     {
     
     }
@@ -40,13 +45,23 @@ class DFBB_BuildOrderStackSearch
 					
     Timer                               _searchTimer;
     BuildOrder                          _buildOrder;
+    DFBB_TranspositionTable             _transpositionTable;
 
+    GameState                           _state;                       //the state at the current depth, children are done on it and undone
     std::vector<StackData>              _stack;
     size_t                              _depth;
 
     bool                                _firstSearch;
 
     bool                                _wasInterrupted;
+
+    std::shared_ptr<DFBB_ParallelSearchData>                    _parallel;          // shared by the workers of a parallel search
+    std::vector< std::shared_ptr<DFBB_BuildOrderStackSearch> >  _workers;           // the searches the threads run, if this search is parallel
+    size_t                              _workerIndex;                 //this search's index among the workers
+    bool                                _workInProgress;              //a worker has a work item on its stack it hasn't finished
+    bool                                _rootActionGiven;             //depth 0's only child came from a work item, so don't generate it
+
+    DFBB_LowerBound                     _lowerBound;                  //the lower bound on the goal's finish time, set up once for the goal
     
     void                                updateResults(const GameState & state);
     bool                                isTimeOut();
@@ -56,6 +71,11 @@ class DFBB_BuildOrderStackSearch
     UnitCountType                       getRepetitions(const GameState & state, const ActionType & a);
     ActionSet                           calculateRelevantActions();
 
+    void                                parallelSearch();
+    void                                workerSearch();
+    void                                startWorkItem(const DFBB_WorkItem & item);
+    void                                splitWork();
+
 public:
 	
 	DFBB_BuildOrderStackSearch(const DFBB_BuildOrderSearchParameters & p);
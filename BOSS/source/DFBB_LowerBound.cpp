@@ -0,0 +1,276 @@
+#include "DFBB_LowerBound.h"
+#include "ActionTypeTable.h"
+
+using namespace BOSS;
+
+DFBB_LowerBound::DFBB_LowerBound(const BuildOrderSearchGoal & goal, const bool useLandmark, const bool useResource)
+    : _race(goal.getRace())
+    , _useLandmark(useLandmark)
+    , _useResource(useResource)
+    , _worker(0)
+    , _refinery(0)
+    , _maxWorkers(0)
+    , _maxRefineries(0)
+    , _mineralsPerSupply(0)
+    , _supplyBuildTime(0)
+{
+    std::fill(_goalCount, _goalCount + Constants::MAX_ACTION_TYPES, 0);
+
+    if (_race == Races::None)
+    {
+        return;
+    }
+
+    const ActionTypeTable::RaceTable & table = ActionTypeTable::Get(_race);
+    const ActionType & worker = ActionTypes::GetWorker(_race);
+    const ActionType & refinery = ActionTypes::GetRefinery(_race);
+
+    _worker = worker.ID();
+    _refinery = refinery.ID();
+    _maxWorkers = std::max(goal.getGoal(worker), goal.getGoalMax(worker));
+    _maxRefineries = std::max(goal.getGoal(refinery), goal.getGoalMax(refinery));
+
+    bool foundSupply = false;
+    for (ActionID a(0); a < ActionTypes::GetAllActionTypes(_race).size(); ++a)
+    {
+        const ActionType & actionType = ActionTypes::GetActionType(_race, a);
+
+        if (goal.getGoal(actionType) > 0)
+        {
+            _goalActions.add(a);
+            _goalCount[a] = goal.getGoal(actionType);
+        }
+
+        // a morph that doesn't use up a worker turns one unit into another, which still counts towards
+        // the goal for the unit it came from (a lair is a hatchery) so count it there, as isAchievedBy does
+        const ActionID builder = table.whatBuilds[a];
+        if ((table.flags[a] & ActionTypeTable::Morphed) && builder < Constants::MAX_ACTION_TYPES && !(table.flags[builder] & ActionTypeTable::Worker))
+        {
+            _morphsInto[builder].add(a);
+        }
+
+        // morphing a lair from a hatchery doesn't add the lair's supply, so only count what can be built
+        if (table.supplyProvided[a] > 0 && !(table.flags[a] & ActionTypeTable::Morphed))
+        {
+            const double mineralsPerSupply = (double)table.mineralPrice[a] / table.supplyProvided[a];
+
+            if (!foundSupply || mineralsPerSupply < _mineralsPerSupply)
+            {
+                _mineralsPerSupply = mineralsPerSupply;
+            }
+
+            if (!foundSupply || table.buildTime[a] < _supplyBuildTime)
+            {
+                _supplyBuildTime = table.buildTime[a];
+            }
+
+            foundSupply = true;
+        }
+    }
+}
+
+const int DFBB_LowerBound::getNumHave(const GameState & state, const ActionID & action) const
+{
+    int have = state.getUnitData().getNumTotal(ActionTypes::GetActionType(_race, action));
+
+    const ActionBitSet & morphs = _morphsInto[action];
+    for (size_t m(morphs.next(0)); m < Constants::MAX_ACTION_TYPES; m = morphs.next(m + 1))
+    {
+        have += getNumHave(state, (ActionID)m);
+    }
+
+    return have;
+}
+
+// path holds the critical path of every action in visited, so each action is only worked out once per state
+FrameCountType DFBB_LowerBound::getCriticalPath(const GameState & state, const ActionID & action, FrameCountType * path, ActionBitSet & visited) const
+{
+    if (visited.contains(action))
+    {
+        return path[action];
+    }
+
+    // a prerequisite cycle reads 0 while it is being worked out, which only makes the bound smaller
+    visited.add(action);
+    path[action] = 0;
+
+    const ActionType & actionType = ActionTypes::GetActionType(_race, action);
+    const UnitData & units = state.getUnitData();
+    FrameCountType length = 0;
+
+    // if we already have the action completed it's not on the path
+    if (units.getNumCompleted(actionType) > 0)
+    {
+        length = 0;
+    }
+    // if we have it in progress the path is the time until it finishes
+    else if (units.getNumInProgress(actionType) > 0)
+    {
+        length = units.getFinishTime(actionType) - state.getCurrentFrame();
+    }
+    // otherwise it has to be built after the longest path to its prerequisites
+    else
+    {
+        const ActionTypeTable::RaceTable & table = ActionTypeTable::Get(_race);
+        const ActionBitSet & prerequisites = table.prerequisites[action];
+
+        FrameCountType longest = 0;
+        for (size_t p(prerequisites.next(0)); p < Constants::MAX_ACTION_TYPES; p = prerequisites.next(p + 1))
+        {
+            longest = std::max(longest, getCriticalPath(state, (ActionID)p, path, visited));
+        }
+
+        length = table.buildTime[action] + longest;
+    }
+
+    path[action] = length;
+    return length;
+}
+
+const FrameCountType DFBB_LowerBound::getLandmarkLowerBound(const GameState & state) const
+{
+    FrameCountType path[Constants::MAX_ACTION_TYPES];
+    ActionBitSet visited;
+    FrameCountType lowerBound = 0;
+
+    for (size_t a(_goalActions.next(0)); a < Constants::MAX_ACTION_TYPES; a = _goalActions.next(a + 1))
+    {
+        if (_goalCount[a] > state.getUnitData().getNumTotal(ActionTypes::GetActionType(_race, (ActionID)a)))
+        {
+            lowerBound = std::max(lowerBound, getCriticalPath(state, (ActionID)a, path, visited));
+        }
+    }
+
+    return lowerBound;
+}
+
+const FrameCountType DFBB_LowerBound::getResourceLowerBound(const GameState & state) const
+{
+    const ActionTypeTable::RaceTable & table = ActionTypeTable::Get(_race);
+    const UnitData & units = state.getUnitData();
+
+    double minerals = 0;
+    double gas = 0;
+    int supplyRequired = 0;
+    int supplyProvided = 0;
+    FrameCountType minBuildTime = 0;
+    ActionBitSet bought;
+    ActionBitSet toExpand;
+    ActionBitSet visited;
+
+    auto buy = [&](const ActionID a, const int num)
+    {
+        minerals += (double)num * table.mineralPrice[a];
+        gas += (double)num * table.gasPrice[a];
+        supplyProvided += num * table.supplyProvided[a];
+
+        // a morph doesn't add its own supply, and a zerg morph from a unit gives back the supply of that unit
+        if (!(table.flags[a] & ActionTypeTable::Morphed))
+        {
+            supplyRequired += num * table.supplyRequired[a] * std::max(1, (int)table.numProduced[a]);
+        }
+
+        const ActionID builder = table.whatBuilds[a];
+        if (_race == Races::Zerg && builder < Constants::MAX_ACTION_TYPES && !(table.flags[a] & (ActionTypeTable::WhatBuildsIsBuilding | ActionTypeTable::WhatBuildsIsLarva)))
+        {
+            supplyRequired -= num * table.supplyRequired[builder];
+        }
+
+        minBuildTime = bought.isEmpty() ? table.buildTime[a] : std::min(minBuildTime, (FrameCountType)table.buildTime[a]);
+        bought.add(a);
+    };
+
+    // every build still needed for the goal
+    for (size_t a(_goalActions.next(0)); a < Constants::MAX_ACTION_TYPES; a = _goalActions.next(a + 1))
+    {
+        const int missing = _goalCount[a] - getNumHave(state, (ActionID)a);
+
+        if (missing > 0)
+        {
+            const int numProduced = std::max(1, (int)table.numProduced[a]);
+            buy((ActionID)a, (missing + numProduced - 1) / numProduced);
+            toExpand.add((ActionID)a);
+            visited.add((ActionID)a);
+        }
+    }
+
+    // and one of every prerequisite of those we don't have any of, along with their own missing prerequisites
+    while (!toExpand.isEmpty())
+    {
+        const ActionID a = (ActionID)toExpand.next(0);
+        toExpand.remove(a);
+
+        ActionBitSet prerequisites = table.prerequisites[a];
+        prerequisites -= visited;
+        visited |= prerequisites;
+
+        for (size_t p(prerequisites.next(0)); p < Constants::MAX_ACTION_TYPES; p = prerequisites.next(p + 1))
+        {
+            if (getNumHave(state, (ActionID)p) == 0)
+            {
+                buy((ActionID)p, 1);
+                toExpand.add((ActionID)p);
+            }
+        }
+    }
+
+    if (bought.isEmpty())
+    {
+        return 0;
+    }
+
+    // gas can only be mined from a refinery
+    if (gas > state.getGas() && !bought.contains(_refinery) && units.getNumTotal(ActionTypes::GetActionType(_race, _refinery)) == 0)
+    {
+        buy(_refinery, 1);
+    }
+
+    // any supply the state won't have after building all that has to be bought at the cheapest price there is
+    const int supplyDeficit = units.getCurrentSupply() + supplyRequired - (units.getMaxSupply() + units.getSupplyInProgress() + supplyProvided);
+    if (supplyDeficit > 0)
+    {
+        minerals += supplyDeficit * _mineralsPerSupply;
+        minBuildTime = std::min(minBuildTime, _supplyBuildTime);
+    }
+
+    // the fastest we could mine is with every worker the search may build on minerals, and as many as fit on gas
+    const int workers = std::max((int)units.getNumTotal(ActionTypes::GetActionType(_race, _worker)), (int)_maxWorkers);
+    const int refineries = std::max((int)units.getNumTotal(ActionTypes::GetActionType(_race, _refinery)), (int)_maxRefineries);
+    const int gasWorkers = std::min(workers, 3 * refineries);
+    FrameCountType gatherTime = 0;
+
+    if (minerals > state.getMinerals() && workers > 0)
+    {
+        gatherTime = std::max(gatherTime, (FrameCountType)((minerals - state.getMinerals()) / (workers * Constants::MPWPF)));
+    }
+
+    if (gas > state.getGas() && gasWorkers > 0)
+    {
+        gatherTime = std::max(gatherTime, (FrameCountType)((gas - state.getGas()) / (gasWorkers * Constants::GPWPF)));
+    }
+
+    // the last thing bought can't start before its resources are gathered, and has to finish too
+    return gatherTime + minBuildTime;
+}
+
+const FrameCountType DFBB_LowerBound::getLowerBound(const GameState & state) const
+{
+    if (_race == Races::None)
+    {
+        return 0;
+    }
+
+    FrameCountType lowerBound = 0;
+
+    if (_useLandmark)
+    {
+        lowerBound = std::max(lowerBound, getLandmarkLowerBound(state));
+    }
+
+    if (_useResource)
+    {
+        lowerBound = std::max(lowerBound, getResourceLowerBound(state));
+    }
+
+    return lowerBound;
+}
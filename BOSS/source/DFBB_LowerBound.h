@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Common.h"
+#include "ActionBitSet.hpp"
+#include "GameState.h"
+#include "BuildOrderSearchGoal.h"
+
+namespace BOSS
+{
+
+// an admissible lower bound on the number of frames from a state until the goal can be finished
+// everything that only depends on the goal is worked out once when the bound is constructed, so bounding
+// a state only visits the actions the goal still wants and the prerequisites they're missing
+class DFBB_LowerBound
+{
+    RaceID              _race;
+    bool                _useLandmark;
+    bool                _useResource;
+
+    ActionBitSet        _goalActions;                                   // actions the goal wants at least one of
+    UnitCountType       _goalCount[Constants::MAX_ACTION_TYPES];       // how many of each the goal wants
+    ActionBitSet        _morphsInto[Constants::MAX_ACTION_TYPES];      // the non-worker actions which morph each action into something else
+
+    ActionID            _worker;
+    ActionID            _refinery;
+    UnitCountType       _maxWorkers;                                    // the most workers or refineries the goal lets the search build
+    UnitCountType       _maxRefineries;
+
+    double              _mineralsPerSupply;                             // the cheapest supply available, in minerals per supply
+    FrameCountType      _supplyBuildTime;                               // the shortest build time of anything that provides supply
+
+    FrameCountType      getCriticalPath(const GameState & state, const ActionID & action, FrameCountType * path, ActionBitSet & visited) const;
+    const int           getNumHave(const GameState & state, const ActionID & action) const;
+
+public:
+
+    DFBB_LowerBound(const BuildOrderSearchGoal & goal, const bool useLandmark = true, const bool useResource = true);
+
+    // the longest chain of build times from the state to an action the goal still wants
+    const FrameCountType getLandmarkLowerBound(const GameState & state) const;
+
+    // the time to gather the resources for everything the goal still wants, plus the shortest build time among them
+    const FrameCountType getResourceLowerBound(const GameState & state) const;
+
+    const FrameCountType getLowerBound(const GameState & state) const;
+};
+
+}
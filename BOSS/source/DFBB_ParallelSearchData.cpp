@@ -0,0 +1,107 @@
+#include "DFBB_ParallelSearchData.h"
+#include <thread>
+
+using namespace BOSS;
+
+DFBB_ParallelSearchData::DFBB_ParallelSearchData(const size_t numWorkers, const int initialUpperBound)
+    : upperBound(initialUpperBound)
+    , stop(false)
+    , idleWorkers(0)
+{
+    BOSS_ASSERT(numWorkers > 0, "Parallel search needs at least one worker");
+
+    for (size_t w(0); w < numWorkers; ++w)
+    {
+        _queues.push_back(std::shared_ptr<DFBB_WorkQueue>(new DFBB_WorkQueue()));
+    }
+
+    _results.upperBound = initialUpperBound;
+}
+
+const size_t DFBB_ParallelSearchData::numWorkers() const
+{
+    return _queues.size();
+}
+
+void DFBB_ParallelSearchData::addWork(const size_t worker, const DFBB_WorkItem & item)
+{
+    std::lock_guard<std::mutex> lock(_queues[worker]->mutex);
+    _queues[worker]->items.push_back(item);
+}
+
+bool DFBB_ParallelSearchData::hasWork(const size_t worker)
+{
+    std::lock_guard<std::mutex> lock(_queues[worker]->mutex);
+    return !_queues[worker]->items.empty();
+}
+
+bool DFBB_ParallelSearchData::getWork(const size_t worker, DFBB_WorkItem & item)
+{
+    {
+        DFBB_WorkQueue & queue = *_queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.items.empty())
+        {
+            item = queue.items.back();
+            queue.items.pop_back();
+            return true;
+        }
+    }
+
+    // only a worker with work can add items, and only to its own queue, which was empty when it went idle
+    // so once every worker is counted idle no more work can appear. a worker stops counting itself idle
+    // while it tries to steal so that the others can't see everyone idle while it holds an item
+    ++idleWorkers;
+    while (!stop)
+    {
+        if (idleWorkers == numWorkers())
+        {
+            return false;
+        }
+
+        --idleWorkers;
+        for (size_t v(1); v < numWorkers(); ++v)
+        {
+            DFBB_WorkQueue & victim = *_queues[(worker + v) % numWorkers()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+
+            if (!victim.items.empty())
+            {
+                item = victim.items.front();
+                victim.items.pop_front();
+                return true;
+            }
+        }
+        ++idleWorkers;
+
+        std::this_thread::yield();
+    }
+
+    return false;
+}
+
+void DFBB_ParallelSearchData::offerSolution(const BuildOrder & buildOrder, const GameState & state, const double timeElapsed)
+{
+    std::lock_guard<std::mutex> lock(_resultsMutex);
+
+    FrameCountType finishTime = state.getLastActionFinishTime();
+
+    // another worker may have found a better one since this worker last read the upper bound
+    if (finishTime < _results.upperBound)
+    {
+        _results.timeElapsed = timeElapsed;
+        _results.upperBound = finishTime;
+        _results.solutionFound = true;
+        _results.finalState = state;
+        _results.buildOrder = buildOrder;
+        upperBound = finishTime;
+
+        _results.printResults(true);
+    }
+}
+
+const DFBB_BuildOrderSearchResults & DFBB_ParallelSearchData::getResults() const
+{
+    return _results;
+}
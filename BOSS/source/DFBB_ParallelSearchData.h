@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Common.h"
+#include "ActionType.h"
+#include "BuildOrder.h"
+#include "GameState.h"
+#include "DFBB_BuildOrderSearchResults.h"
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+
+namespace BOSS
+{
+
+// an unsearched subtree of a parallel DFBB search
+// prefix leads from the initial state to the parent of the subtree, and action is the child of
+// that parent to search. an item with no action searches every child of the state prefix leads to
+class DFBB_WorkItem
+{
+public:
+
+    BuildOrder          prefix;
+    ActionType          action;
+};
+
+// the work queue of one worker, the owner adds and takes items at the back and other workers steal
+// from the front, so a thief gets the item nearest the top of the tree, which is likely the largest
+class DFBB_WorkQueue
+{
+public:
+
+    std::mutex                  mutex;
+    std::deque<DFBB_WorkItem>   items;
+};
+
+// everything the workers of a parallel DFBB search share
+class DFBB_ParallelSearchData
+{
+    std::vector< std::shared_ptr<DFBB_WorkQueue> >  _queues;
+    std::mutex                                      _resultsMutex;
+    DFBB_BuildOrderSearchResults                    _results;       // the best solution found by any worker
+
+public:
+
+    std::atomic<int>            upperBound;     // _results.upperBound, read by workers at every node
+    std::atomic<bool>           stop;           // set by the first worker to time out, the others stop at their next node
+    std::atomic<size_t>         idleWorkers;    // workers without work, busy workers split their subtrees while this is non-zero
+
+    DFBB_ParallelSearchData(const size_t numWorkers, const int initialUpperBound);
+
+    const size_t                numWorkers() const;
+
+    void                        addWork(const size_t worker, const DFBB_WorkItem & item);
+    bool                        hasWork(const size_t worker);
+
+    // takes an item from the worker's own queue, or steals one from another worker's
+    // returns false once every worker is out of work, or when the search is stopped
+    bool                        getWork(const size_t worker, DFBB_WorkItem & item);
+
+    void                        offerSolution(const BuildOrder & buildOrder, const GameState & state, const double timeElapsed);
+    const DFBB_BuildOrderSearchResults & getResults() const;
+};
+}
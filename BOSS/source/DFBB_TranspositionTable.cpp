@@ -0,0 +1,91 @@
+#include "DFBB_TranspositionTable.h"
+
+using namespace BOSS;
+
+// the number of entries a table starts with
+const size_t InitialTableSize = 1 << 12;
+
+DFBB_TranspositionTable::DFBB_TranspositionTable()
+    : _mask(0)
+    , _maxSize(0)
+    , _numStored(0)
+{
+
+}
+
+void DFBB_TranspositionTable::resize(const size_t size)
+{
+    _maxSize = 1;
+    while (_maxSize < size)
+    {
+        _maxSize <<= 1;
+    }
+
+    const size_t initialSize = std::min(_maxSize, InitialTableSize);
+    _entries = std::vector<DFBB_TranspositionTableEntry>(initialSize);
+    _mask = initialSize - 1;
+    _numStored = 0;
+}
+
+void DFBB_TranspositionTable::clear()
+{
+    std::fill(_entries.begin(), _entries.end(), DFBB_TranspositionTableEntry());
+    _numStored = 0;
+}
+
+// doubles the table, each entry either stays in its slot or moves to the same slot in the new half
+// so every stored state is kept
+void DFBB_TranspositionTable::grow()
+{
+    const size_t oldSize = _entries.size();
+
+    _entries.resize(oldSize * 2);
+    _mask = _entries.size() - 1;
+    _numStored = 0;
+
+    for (size_t i(0); i < oldSize; ++i)
+    {
+        if ((_entries[i].hash & _mask) != i)
+        {
+            _entries[i + oldSize] = _entries[i];
+            _entries[i] = DFBB_TranspositionTableEntry();
+        }
+    }
+}
+
+size_t DFBB_TranspositionTable::size() const
+{
+    return _entries.size();
+}
+
+bool DFBB_TranspositionTable::isDominated(const GameState & state)
+{
+    BOSS_ASSERT(!_entries.empty(), "Transposition table used before being sized");
+
+    const HashType hash = state.calculateHash();
+    const DFBB_TranspositionTableEntry & stored = _entries[hash & _mask];
+
+    // same units, buildings and actions in progress, reached no later and with no fewer resources
+    if (stored.hash == hash && stored.frame <= state.getCurrentFrame() && stored.minerals >= state.getMinerals() && stored.gas >= state.getGas())
+    {
+        return true;
+    }
+
+    // once as many states have been stored as there are entries, collisions are throwing states away, so grow
+    if (++_numStored > _entries.size() && _entries.size() < _maxSize)
+    {
+        grow();
+    }
+
+    DFBB_TranspositionTableEntry & entry = _entries[hash & _mask];
+
+    // always replace, even when the stored state is the same one reached earlier or with more resources
+    // the search is depth first, so the state it just reached is the one its siblings reach again. keeping
+    // the entry which dominates more states instead expands up to 70% more nodes on the sample goals
+    entry.hash      = hash;
+    entry.frame     = state.getCurrentFrame();
+    entry.minerals  = state.getMinerals();
+    entry.gas       = state.getGas();
+
+    return false;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Common.h"
+#include "GameState.h"
+
+namespace BOSS
+{
+
+class DFBB_TranspositionTableEntry
+{
+public:
+
+    HashType            hash;
+    FrameCountType      frame;
+    ResourceCountType   minerals;
+    ResourceCountType   gas;
+
+    DFBB_TranspositionTableEntry()
+        : hash(0)
+        , frame(0)
+        , minerals(0)
+        , gas(0)
+    {
+    
+    }
+};
+
+// always-replace table keyed on GameState::calculateHash()
+// used by DFBB to skip states which are dominated by a previously searched state
+// the table starts small and doubles up to its maximum size as states are stored, so a search which
+// only expands a few nodes doesn't allocate and clear the whole table
+class DFBB_TranspositionTable
+{
+    std::vector<DFBB_TranspositionTableEntry>   _entries;
+    size_t                                      _mask;
+    size_t                                      _maxSize;
+    size_t                                      _numStored;     // states stored since the table last grew
+
+    void    grow();
+
+public:
+
+    DFBB_TranspositionTable();
+
+    // sets the most entries the table may grow to, rounded up to a power of 2
+    void    resize(const size_t size);
+    void    clear();
+    size_t  size() const;
+
+    // returns true if state is dominated by the stored entry, otherwise stores state and returns false
+    bool    isDominated(const GameState & state);
+};
+}
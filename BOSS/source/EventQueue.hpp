@@ -0,0 +1,187 @@
+#pragma once
+
+#include "Common.h"
+#include "BOSSAssert.h"
+#include <algorithm>
+
+namespace BOSS
+{
+
+// something that will happen at an absolute frame, and what it happens to
+template <class T>
+class Event
+{
+public:
+
+    FrameCountType  frame;
+    T               data;
+
+    Event()
+        : frame(0)
+        , data()
+    {
+    }
+
+    Event(const FrameCountType f, const T & d)
+        : frame(f)
+        , data(d)
+    {
+    }
+};
+
+// a binary min-heap of events ordered by the frame they happen at
+// adding an event or taking the next one is O(log n), so fast forwarding only touches the events that
+// happen before the frame it stops at instead of counting down a timer on everything that has one
+// events on the same frame come out in no particular order
+template <class T, size_t max_capacity>
+class EventQueue
+{
+    size_t      _size;
+    Event<T>    _heap[max_capacity];
+
+    void siftUp(size_t i)
+    {
+        while (i > 0)
+        {
+            const size_t parent = (i - 1) / 2;
+
+            if (_heap[parent].frame <= _heap[i].frame)
+            {
+                break;
+            }
+
+            std::swap(_heap[parent], _heap[i]);
+            i = parent;
+        }
+    }
+
+    void siftDown(size_t i)
+    {
+        while (true)
+        {
+            const size_t left = 2 * i + 1;
+            const size_t right = left + 1;
+            size_t smallest = i;
+
+            if (left < _size && _heap[left].frame < _heap[smallest].frame)
+            {
+                smallest = left;
+            }
+
+            if (right < _size && _heap[right].frame < _heap[smallest].frame)
+            {
+                smallest = right;
+            }
+
+            if (smallest == i)
+            {
+                break;
+            }
+
+            std::swap(_heap[smallest], _heap[i]);
+            i = smallest;
+        }
+    }
+
+public:
+
+    EventQueue()
+        : _size(0)
+    {
+    }
+
+    // copies only the events in the queue, like Vec
+    EventQueue(const EventQueue & rhs)
+        : _size(rhs._size)
+    {
+        std::copy(rhs._heap, rhs._heap + rhs._size, _heap);
+    }
+
+    EventQueue & operator = (const EventQueue & rhs)
+    {
+        if (this != &rhs)
+        {
+            _size = rhs._size;
+            std::copy(rhs._heap, rhs._heap + rhs._size, _heap);
+        }
+
+        return *this;
+    }
+
+    void push(const FrameCountType frame, const T & data)
+    {
+        BOSS_ASSERT(_size < max_capacity, "Event queue over capacity: %d", (int)max_capacity);
+
+        _heap[_size] = Event<T>(frame, data);
+        siftUp(_size);
+        ++_size;
+    }
+
+    // the frame of the next event to happen
+    const FrameCountType nextFrame() const
+    {
+        BOSS_ASSERT(!empty(), "No events in the queue");
+
+        return _heap[0].frame;
+    }
+
+    const T & next() const
+    {
+        BOSS_ASSERT(!empty(), "No events in the queue");
+
+        return _heap[0].data;
+    }
+
+    void pop()
+    {
+        BOSS_ASSERT(!empty(), "Can't pop from an empty event queue");
+
+        --_size;
+
+        if (_size > 0)
+        {
+            _heap[0] = _heap[_size];
+            siftDown(0);
+        }
+    }
+
+    // removes an event which is in the queue, used to take back a push
+    void remove(const FrameCountType frame, const T & data)
+    {
+        for (size_t i(0); i < _size; ++i)
+        {
+            if (_heap[i].frame == frame && _heap[i].data == data)
+            {
+                --_size;
+
+                if (i < _size)
+                {
+                    _heap[i] = _heap[_size];
+                    siftDown(i);
+                    siftUp(i);
+                }
+
+                return;
+            }
+        }
+
+        BOSS_ASSERT(false, "Event to remove is not in the queue");
+    }
+
+    const bool empty() const
+    {
+        return _size == 0;
+    }
+
+    const size_t & size() const
+    {
+        return _size;
+    }
+
+    void clear()
+    {
+        _size = 0;
+    }
+};
+
+}
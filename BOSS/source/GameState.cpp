@@ -1,4 +1,5 @@
 #include "GameState.h"
+#include "Hash.h"
 
 using namespace BOSS;
 
@@ -10,6 +11,7 @@ GameState::GameState(const RaceID r)
     , _lastActionFrame      (0)
     , _minerals             (0)
     , _gas                  (0)
+    , _trackActionsPerformed(true)
 {
     
 }
@@ -22,6 +24,7 @@ GameState::GameState(BWAPI::GameWrapper & game, BWAPI::PlayerInterface * self, c
     , _units                (Races::GetRaceID(self->getRace()))
     , _minerals             (self->minerals() * Constants::RESOURCE_SCALE)
     , _gas                  (self->gas() * Constants::RESOURCE_SCALE)
+    , _trackActionsPerformed(true)
 { 
     // we will count the worker jobs as we add units
     UnitCountType mineralWorkerCount    = 0;
@@ -33,6 +36,9 @@ GameState::GameState(BWAPI::GameWrapper & game, BWAPI::PlayerInterface * self, c
     _units.setGasWorkers(gasWorkerCount);
     _units.setBuildingWorkers(buildingWorkerCount);
 
+    // the buildings we add are given their time until free from the current frame
+    _units.setBuildingFrame(_currentFrame);
+
     // add buildings queued like they had just been started
     for (const BWAPI::UnitType & type : buildingsQueued)
     {
@@ -227,6 +233,7 @@ void GameState::setStartingState()
     }
 
     _units.setCurrentSupply(8);
+    _resourceTimeline.clear();
 }
 
 const RaceID GameState::getRace() const
@@ -336,12 +343,16 @@ bool GameState::isLegal(const ActionType & action) const
 }
 
 // do an action, action must be legal for this not to break
-std::vector<ActionType> GameState::doAction(const ActionType & action)
+// if an undo saved from this state is given, the changes are recorded in it so undo can reverse them
+std::vector<ActionType> GameState::doAction(const ActionType & action, GameStateUndo * undo)
 {
     BOSS_ASSERT(action.getRace() == _race, "Race of action does not match race of the state");
 
-    _actionsPerformed.push_back(ActionPerformed());
-    _actionsPerformed[_actionsPerformed.size()-1].actionType = action;
+    if (_trackActionsPerformed)
+    {
+        _actionsPerformed.push_back(ActionPerformed());
+        _actionsPerformed[_actionsPerformed.size()-1].actionType = action;
+    }
 
     BOSS_ASSERT(isLegal(action), "Trying to perform an illegal action: %s %s", action.getName().c_str(), getActionsPerformedString().c_str());
     
@@ -352,15 +363,16 @@ std::vector<ActionType> GameState::doAction(const ActionType & action)
     FrameCountType workerReadyTime = whenWorkerReady(action);
     FrameCountType ffTime = whenCanPerform(action);
 
-    const std::string & name = action.getName();
-
     BOSS_ASSERT(ffTime >= 0 && ffTime < 1000000, "FFTime is very strange: %d", ffTime);
 
-    auto actionsFinished = fastForward(ffTime);
+    auto actionsFinished = fastForward(ffTime, undo);
 
-    _actionsPerformed[_actionsPerformed.size()-1].actionQueuedFrame = _currentFrame;
-    _actionsPerformed[_actionsPerformed.size()-1].gasWhenQueued = _gas;
-    _actionsPerformed[_actionsPerformed.size()-1].mineralsWhenQueued = _minerals;
+    if (_trackActionsPerformed)
+    {
+        _actionsPerformed[_actionsPerformed.size()-1].actionQueuedFrame = _currentFrame;
+        _actionsPerformed[_actionsPerformed.size()-1].gasWhenQueued = _gas;
+        _actionsPerformed[_actionsPerformed.size()-1].mineralsWhenQueued = _minerals;
+    }
 
     // how much time has elapsed since the last action was queued?
     FrameCountType elapsed(_currentFrame - _lastActionFrame);
@@ -373,10 +385,12 @@ std::vector<ActionType> GameState::doAction(const ActionType & action)
     _minerals   -= action.mineralPrice();
     _gas        -= action.gasPrice();
 
+    UnitDataUndo * unitUndo = undo ? &undo->_units : nullptr;
+
     // do race specific things here
     if (getRace() == Races::Protoss)
     {
-        _units.addActionInProgress(action, _currentFrame + action.buildTime());    
+        _units.addActionInProgress(action, _currentFrame + action.buildTime(), true, unitUndo);    
     }
     else if (getRace() == Races::Terran)
     {
@@ -386,7 +400,7 @@ std::vector<ActionType> GameState::doAction(const ActionType & action)
             _units.setBuildingWorker();
         }
 
-        _units.addActionInProgress(action, _currentFrame + action.buildTime());
+        _units.addActionInProgress(action, _currentFrame + action.buildTime(), true, unitUndo);
     }
     else if (getRace() == Races::Zerg)
     {
@@ -395,35 +409,68 @@ std::vector<ActionType> GameState::doAction(const ActionType & action)
         {
             if (action.isMorphed())
             {
-                _units.morphUnit(action.whatBuildsActionType(), action, _currentFrame + action.buildTime());   
+                _units.morphUnit(action.whatBuildsActionType(), action, _currentFrame + action.buildTime(), unitUndo);   
             }
             else
             {
                 BOSS_ASSERT(getHatcheryData().numLarva() > 0, "We should have a larva to use");
                 _units.getHatcheryData().useLarva();
-                _units.addActionInProgress(action, _currentFrame + action.buildTime());
+                _units.addActionInProgress(action, _currentFrame + action.buildTime(), true, unitUndo);
             }
      	}
      	else if (action.isBuilding())
      	{
-            _units.morphUnit(action.whatBuildsActionType(), action, _currentFrame + action.buildTime());
+            _units.morphUnit(action.whatBuildsActionType(), action, _currentFrame + action.buildTime(), unitUndo);
      	}
         else
         {
             // if it's not a unit or a building it's a tech so we queue it normally
-            _units.addActionInProgress(action, _currentFrame + action.buildTime());
+            _units.addActionInProgress(action, _currentFrame + action.buildTime(), true, unitUndo);
         }
      }
 
+    // the new action in progress changes the income to come
+    _resourceTimeline.clear();
+
 	return actionsFinished;
 }
 
+void GameState::saveUndo(GameStateUndo & undo) const
+{
+    _units.saveUndo(undo._units);
+    undo._actionPerformed       = _actionPerformed;
+    undo._actionPerformedK      = _actionPerformedK;
+    undo._currentFrame          = _currentFrame;
+    undo._lastActionFrame       = _lastActionFrame;
+    undo._minerals              = _minerals;
+    undo._gas                   = _gas;
+    undo._numActionsPerformed   = _actionsPerformed.size();
+}
+
+// puts the state back the way it was when undo was saved, any actions done since then are forgotten
+void GameState::undo(const GameStateUndo & undo)
+{
+    BOSS_ASSERT(undo._numActionsPerformed <= _actionsPerformed.size(), "Undo was saved from a different state");
+
+    _units.undo(undo._units);
+    _actionPerformed    = undo._actionPerformed;
+    _actionPerformedK   = undo._actionPerformedK;
+    _currentFrame       = undo._currentFrame;
+    _lastActionFrame    = undo._lastActionFrame;
+    _minerals           = undo._minerals;
+    _gas                = undo._gas;
+    _actionsPerformed.resize(undo._numActionsPerformed);
+    _resourceTimeline.clear();
+}
+
 // fast forwards the current state to time toFrame
-std::vector<ActionType> GameState::fastForward(const FrameCountType toFrame)
+std::vector<ActionType> GameState::fastForward(const FrameCountType toFrame, GameStateUndo * undo)
 {
-    // fast forward the building timers to the current frame
+    UnitDataUndo * unitUndo = undo ? &undo->_units : nullptr;
+
+    // fast forward the buildings to the frame we're going to
     FrameCountType previousFrame = _currentFrame;
-    _units.setBuildingFrame(toFrame - _currentFrame);
+    _units.setBuildingFrame(toFrame, unitUndo);
 
     // update resources & finish each action
     FrameCountType      lastActionFinished  = _currentFrame;
@@ -448,7 +495,7 @@ std::vector<ActionType> GameState::fastForward(const FrameCountType toFrame)
         lastActionFinished 	= _units.getNextActionFinishTime();
 
         // finish the action, which updates mineral and gas rates if required
-		actionsFinished.push_back(_units.finishNextActionInProgress());
+		actionsFinished.push_back(_units.finishNextActionInProgress(unitUndo));
     }
 
     // update resources from the last action finished to toFrame
@@ -468,14 +515,14 @@ std::vector<ActionType> GameState::fastForward(const FrameCountType toFrame)
         _units.getHatcheryData().fastForward(previousFrame, toFrame);
     }
 
+    _resourceTimeline.clear();
+
 	return actionsFinished;
 }
 
 // returns the time at which all resources to perform an action will be available
 const FrameCountType GameState::whenCanPerform(const ActionType & action) const
 {
-    const std::string & name = action.getName();
-
     // the resource times we care about
     FrameCountType mineralTime  (_currentFrame); 	// minerals
     FrameCountType gasTime      (_currentFrame); 	// gas
@@ -617,11 +664,6 @@ const FrameCountType GameState::whenSupplyReady(const ActionType & action) const
 
 const FrameCountType GameState::whenPrerequisitesReady(const ActionType & action) const
 {
-    if (action == ActionTypes::GetActionType("Protoss_Dark_Templar"))
-    {
-        int a = 6;
-    }
-
     FrameCountType preReqReadyTime = _currentFrame;
 
     // if a building builds this action
@@ -713,93 +755,8 @@ const FrameCountType GameState::whenMineralsReady(const ActionType & action) con
     {
         return getCurrentFrame();
     }
-    
-    UnitCountType currentMineralWorkers     = _units.getNumMineralWorkers();
-    UnitCountType currentGasWorkers         = _units.getNumGasWorkers();
-    FrameCountType lastActionFinishFrame    = _currentFrame;
-    FrameCountType addedTime                = 0;
-    ResourceCountType addedMinerals         = 0;
-    ResourceCountType difference            = action.mineralPrice() - _minerals;
-
-    // loop through each action in progress, adding the minerals we would gather from each interval
-    for (size_t i(0); i<_units.getNumActionsInProgress(); ++i)
-    {
-        // the vector is sorted in descending order
-        size_t progressIndex = _units.getNumActionsInProgress() - i - 1;
-
-        // the time elapsed and the current minerals per frame
-        FrameCountType elapsed = _units.getFinishTimeByIndex(progressIndex) - lastActionFinishFrame;
-        ResourceCountType mineralsPerFrame = (currentMineralWorkers * Constants::MPWPF);
-
-        // the amount of minerals that would be added this time step
-        ResourceCountType tempAdd = elapsed * mineralsPerFrame;
-
-        // if this amount isn't enough, update the amount added for this interval
-        if (addedMinerals + tempAdd < difference)
-        {
-            addedMinerals += tempAdd;
-            addedTime += elapsed;
-        }
-        else
-        {
-            // otherwise we can just break out and update at the end
-            break;
-        }
-
-        // if it was a drone or extractor update the temp variables
-        const ActionType & actionPerformed = _units.getActionInProgressByIndex(progressIndex);
-
-        // finishing a building as terran gives you a mineral worker back
-        if (actionPerformed.isBuilding() && !actionPerformed.isAddon() && (getRace() == Races::Terran))
-        {
-            currentMineralWorkers++;
-        }
-
-        if (actionPerformed.isWorker())
-        {
-            currentMineralWorkers++;
-        }
-        else if (actionPerformed.isRefinery())
-        {
-            BOSS_ASSERT(currentMineralWorkers > 3, "Not enough mineral workers \n");
-            currentMineralWorkers -= 3; 
-            currentGasWorkers += 3;
-        }
-
-
-        // update the last action
-        lastActionFinishFrame = _units.getFinishTimeByIndex(progressIndex);
-    }
-
-    // if we still haven't added enough minerals, add more time
-    if (addedMinerals < difference)
-    {
-        BOSS_ASSERT(currentMineralWorkers > 0, "Shouldn't have 0 mineral workers");
-
-       FrameCountType finalTimeToAdd;
-	   if (currentMineralWorkers != 0)
-		{
-			finalTimeToAdd = (difference - addedMinerals) / (currentMineralWorkers * Constants::MPWPF);
-		}
-		else
-		{
-			finalTimeToAdd = 1000000;
-		}
-        addedMinerals += finalTimeToAdd * currentMineralWorkers * Constants::MPWPF;
-        addedTime     += finalTimeToAdd;
-
-        // the last operation could have added one frame too little due to integer division so we need to check
-        if (addedMinerals < difference)
-        {
-            addedTime += 1;
-            addedMinerals += currentMineralWorkers * Constants::MPWPF;
-        }
-    }
-    
-    BOSS_ASSERT(addedMinerals >= difference, "Mineral prediction error");
 
-    // for some reason if i don't return +1, i mine 1 less mineral in the interval
-    return _currentFrame + addedTime;
+    return _resourceTimeline.whenMineralsGathered(_units, _currentFrame, action.mineralPrice() - _minerals);
 }
 
 const FrameCountType GameState::whenGasReady(const ActionType & action) const
@@ -808,90 +765,51 @@ const FrameCountType GameState::whenGasReady(const ActionType & action) const
     {
         return getCurrentFrame();
     }
-    
-    UnitCountType currentMineralWorkers     = _units.getNumMineralWorkers();
-    UnitCountType currentGasWorkers         = _units.getNumGasWorkers();
-    FrameCountType lastActionFinishFrame    = _currentFrame;
-    FrameCountType addedTime                = 0;
-    ResourceCountType addedGas              = 0;
-    ResourceCountType difference            = action.gasPrice() - _gas;
-
-    // loop through each action in progress, adding the minerals we would gather from each interval
-    for (size_t i(0); i<_units.getNumActionsInProgress(); ++i)
-    {
-        // the vector is sorted in descending order
-        size_t progressIndex = _units.getNumActionsInProgress() - i - 1;
-
-        // the time elapsed and the current minerals per frame
-        FrameCountType elapsed = _units.getFinishTimeByIndex(progressIndex) - lastActionFinishFrame;
-        ResourceCountType gasPerFrame = (currentGasWorkers * Constants::GPWPF);
-
-        // the amount of minerals that would be added this time step
-        ResourceCountType tempAdd = elapsed * gasPerFrame;
 
-        // if this amount isn't enough, update the amount added for this interval
-        if (addedGas + tempAdd < difference)
-        {
-            addedGas += tempAdd;
-            addedTime += elapsed;
-        }
-        else
-        {
-            // otherwise we can just break out and update at the end
-            break;
-        }
-
-        // if it was a drone or extractor update the temp variables
-        const ActionType & actionPerformed = _units.getActionInProgressByIndex(progressIndex);
+    return _resourceTimeline.whenGasGathered(_units, _currentFrame, action.gasPrice() - _gas);
+}
 
-        // finishing a building as terran gives you a mineral worker back
-        if (actionPerformed.isBuilding() && !actionPerformed.isAddon() && (getRace() == Races::Terran))
-        {
-            currentMineralWorkers++;
-        }
+// hash of everything in the state except the current frame and resource counts
+// two states with equal hashes differ only in time and resources, which is what
+// the DFBB transposition table uses to detect dominated states
+// unordered collections are combined with addition so duplicate items don't cancel out
+const HashType GameState::calculateHash() const
+{
+    HashType hash = Hash::Race(_race);
 
-        if (actionPerformed.isWorker())
-        {
-            currentMineralWorkers++;
-        }
-        else if (actionPerformed.isRefinery())
+    const std::vector<ActionType> & allActions = ActionTypes::GetAllActionTypes(_race);
+    for (size_t a(0); a < allActions.size(); ++a)
+    {
+        const UnitCountType numCompleted = _units.getNumCompleted(allActions[a]);
+        if (numCompleted > 0)
         {
-            BOSS_ASSERT(currentMineralWorkers > 3, "Not enough mineral workers");
-            currentMineralWorkers -= 3; currentGasWorkers += 3;
+            hash ^= Hash::UnitCount(allActions[a].ID(), numCompleted);
         }
+    }
 
-        // update the last action
-        lastActionFinishFrame = _units.getFinishTimeByIndex(progressIndex);
+    for (UnitCountType i(0); i < _units.getNumActionsInProgress(); ++i)
+    {
+        hash += Hash::InProgress(_units.getActionInProgressByIndex(i).ID(), _units.getFinishTimeByIndex(i));
     }
 
-    // if we still haven't added enough minerals, add more time
-    if (addedGas < difference)
+    const BuildingData & buildings = _units.getBuildingData();
+    for (size_t i(0); i < buildings.size(); ++i)
     {
-		BOSS_ASSERT(currentGasWorkers > 0, "Shouldn't have 0 gas workers");
-		FrameCountType finalTimeToAdd;
-		if (currentGasWorkers != 0)
-		{
-			finalTimeToAdd = (difference - addedGas) / (currentGasWorkers * Constants::GPWPF);
-		}
-		else
-		{
-			finalTimeToAdd = 1000000;
-		}
-        addedGas    += finalTimeToAdd * currentGasWorkers * Constants::GPWPF;
-        addedTime   += finalTimeToAdd;
+        const BuildingStatus & b = buildings.getBuilding(i);
+        const ActionID constructing = (b._isConstructing == ActionTypes::None) ? (ActionID)Constants::MAX_ACTIONS : b._isConstructing.ID();
+        const ActionID addon = (b._addon == ActionTypes::None) ? (ActionID)Constants::MAX_ACTIONS : b._addon.ID();
+        hash += Hash::Building(b._type.ID(), constructing, addon, b._freeFrame);
+    }
 
-        // the last operation could have added one frame too little due to integer division so we need to check
-        if (addedGas < difference)
-        {
-            addedTime += 1;
-            addedGas += currentGasWorkers * Constants::GPWPF;
-        }
+    const HatcheryData & hatcheries = _units.getHatcheryData();
+    for (UnitCountType i(0); i < hatcheries.size(); ++i)
+    {
+        hash += Hash::Larva(hatcheries.getHatchery(i).numLarva());
     }
-    
-    BOSS_ASSERT(addedGas >= difference, "Gas prediction error");
 
-    // for some reason if i don't return +1, i mine 1 less mineral in the interval
-    return _currentFrame + addedTime;
+    hash ^= Hash::Workers(_units.getNumMineralWorkers(), _units.getNumGasWorkers(), _units.getNumBuildingWorkers());
+
+    return hash;
 }
 
 const FrameCountType GameState::getCurrentFrame() const
@@ -1012,6 +930,8 @@ void GameState::addCompletedAction(const ActionType & action, const size_t num)
         _units.addCompletedAction(action, false);
         _units.setCurrentSupply(_units.getCurrentSupply() + action.supplyRequired());
     }
+
+    _resourceTimeline.clear();
 }
 
 void GameState::removeCompletedAction(const ActionType & action, const size_t num)
@@ -1021,6 +941,14 @@ void GameState::removeCompletedAction(const ActionType & action, const size_t nu
 		_units.setCurrentSupply(_units.getCurrentSupply() - action.supplyRequired());
 		_units.removeCompletedAction(action);
 	}
+
+    _resourceTimeline.clear();
+}
+
+// a search doing millions of actions doesn't need the list of them, and growing it costs an allocation per copy
+void GameState::setTrackActionsPerformed(const bool track)
+{
+    _trackActionsPerformed = track;
 }
 
 const std::string GameState::toString() const
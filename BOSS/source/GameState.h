@@ -8,6 +8,7 @@
 #include "ActionType.h"
 #include "PrerequisiteSet.h"
 #include "ActionSet.h"
+#include "ResourceTimeline.h"
 
 //#define ENABLE_BWAPI_GAMESTATE_CONSTRUCTOR
 
@@ -34,6 +35,37 @@ public:
     }
 };
 
+// the parts of a GameState which doAction can change, saved by GameState::saveUndo
+// a search can then do actions on a single state and roll it back with GameState::undo
+// rather than copying the whole state for every child it generates
+// the unit data changes are recorded by each doAction given the undo, rather than copied
+class GameStateUndo
+{
+    friend class GameState;
+
+    UnitDataUndo                _units;
+    ActionType                  _actionPerformed;
+    size_t                      _actionPerformedK;
+    FrameCountType              _currentFrame;
+    FrameCountType              _lastActionFrame;
+    ResourceCountType           _minerals;
+    ResourceCountType           _gas;
+    size_t                      _numActionsPerformed;
+
+public:
+
+    GameStateUndo()
+        : _actionPerformedK(0)
+        , _currentFrame(0)
+        , _lastActionFrame(0)
+        , _minerals(0)
+        , _gas(0)
+        , _numActionsPerformed(0)
+    {
+
+    }
+};
+
 class GameState 
 {
     UnitData                    _units;  
@@ -49,6 +81,9 @@ class GameState
     ResourceCountType           _gas;						// current gas count
 
     std::vector<ActionPerformed>   _actionsPerformed;
+    bool                        _trackActionsPerformed;     // whether doAction records into _actionsPerformed
+
+    mutable ResourceTimeline    _resourceTimeline;          // income from _units, cleared whenever _units or _currentFrame change
 
     const FrameCountType        raceSpecificWhenReady(const ActionType & a) const;
     void                        fixZergUnitMasks();
@@ -71,10 +106,13 @@ public:
     GameState(BWAPI::GameWrapper & game, BWAPI::PlayerInterface * player, const std::vector<BWAPI::UnitType> & buildingsQueued);
 #endif
 
-	std::vector<ActionType>     doAction(const ActionType & action);
-    std::vector<ActionType>     fastForward(const FrameCountType toFrame) ;
+	std::vector<ActionType>     doAction(const ActionType & action, GameStateUndo * undo = nullptr);
+    std::vector<ActionType>     fastForward(const FrameCountType toFrame, GameStateUndo * undo = nullptr) ;
     void                        finishNextActionInProgress();
 
+    void                        saveUndo(GameStateUndo & undo)                                          const;
+    void                        undo(const GameStateUndo & undo);
+
     const FrameCountType        getCurrentFrame()                                                       const;
     const FrameCountType        whenCanPerform(const ActionType & action)                               const;
     const FrameCountType        getLastActionFinishTime()                                               const;
@@ -104,6 +142,7 @@ public:
 
     const std::string           toString()                      const;
     const std::string           getActionsPerformedString()     const;
+    const HashType              calculateHash()                 const;
     const BuildingData &        getBuildingData()               const;
     const HatcheryData &        getHatcheryData()               const;
 
@@ -112,5 +151,6 @@ public:
     void                        setGas(const ResourceCountType & gas);
     void                        addCompletedAction(const ActionType & action, const size_t num = 1);
 	void                        removeCompletedAction(const ActionType & action, const size_t num = 1);
+    void                        setTrackActionsPerformed(const bool track);
 };
 }
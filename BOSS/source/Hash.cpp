@@ -0,0 +1,103 @@
+#include "Hash.h"
+#include <random>
+
+using namespace BOSS;
+
+namespace BOSS
+{
+namespace Hash
+{
+    HashType    raceHash[Races::NUM_RACES + 2];
+    HashType    unitCountHash[Constants::MAX_ACTIONS][Constants::MAX_OF_ACTION];
+    HashType    inProgressHash[Constants::MAX_ACTIONS];
+    HashType    buildingHash[Constants::MAX_ACTIONS];
+    HashType    constructingHash[Constants::MAX_ACTIONS + 1];
+    HashType    addonHash[Constants::MAX_ACTIONS + 1];
+    HashType    workerHash[3];
+    HashType    larvaHash;
+}
+}
+
+void Hash::init()
+{
+    // fixed seed so that hashes are identical from run to run
+    std::mt19937_64 rng(0x424f5353);
+
+    for (size_t r(0); r < Races::NUM_RACES + 2; ++r)
+    {
+        raceHash[r] = rng();
+    }
+
+    for (size_t a(0); a < Constants::MAX_ACTIONS; ++a)
+    {
+        for (size_t c(0); c < Constants::MAX_OF_ACTION; ++c)
+        {
+            unitCountHash[a][c] = rng();
+        }
+
+        inProgressHash[a]   = rng();
+        buildingHash[a]     = rng();
+    }
+
+    for (size_t a(0); a < Constants::MAX_ACTIONS + 1; ++a)
+    {
+        constructingHash[a] = rng();
+        addonHash[a]        = rng();
+    }
+
+    for (size_t w(0); w < 3; ++w)
+    {
+        workerHash[w] = rng();
+    }
+
+    larvaHash = rng();
+}
+
+// 64 bit finalizer from MurmurHash3
+HashType Hash::Mix(HashType key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+HashType Hash::Race(const RaceID race)
+{
+    return raceHash[race < Races::NUM_RACES ? (size_t)race : (size_t)Races::NUM_RACES];
+}
+
+HashType Hash::UnitCount(const ActionID id, const UnitCountType count)
+{
+    BOSS_ASSERT(id < Constants::MAX_ACTIONS, "Action id out of range for hashing: %d", (int)id);
+
+    if (count < Constants::MAX_OF_ACTION)
+    {
+        return unitCountHash[id][count];
+    }
+
+    return Mix(unitCountHash[id][0] ^ count);
+}
+
+HashType Hash::InProgress(const ActionID id, const FrameCountType finishFrame)
+{
+    return Mix(inProgressHash[id] ^ (HashType)finishFrame);
+}
+
+// constructing and addon ids of MAX_ACTIONS denote ActionTypes::None
+HashType Hash::Building(const ActionID type, const ActionID constructing, const ActionID addon, const FrameCountType freeFrame)
+{
+    return Mix(buildingHash[type] ^ constructingHash[constructing] ^ addonHash[addon] ^ ((HashType)freeFrame << 20));
+}
+
+HashType Hash::Workers(const UnitCountType mineral, const UnitCountType gas, const UnitCountType building)
+{
+    return Mix(workerHash[0] ^ mineral) ^ Mix(workerHash[1] ^ gas) ^ Mix(workerHash[2] ^ building);
+}
+
+HashType Hash::Larva(const UnitCountType numLarva)
+{
+    return Mix(larvaHash ^ numLarva);
+}
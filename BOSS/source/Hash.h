@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Common.h"
+
+namespace BOSS
+{
+namespace Hash
+{
+    // Zobrist style random values used to hash the components of a GameState
+    // unit counts use a lookup table, frame dependent values are mixed in with Mix()
+    void        init();
+
+    HashType    Mix(HashType key);
+
+    HashType    Race(const RaceID race);
+    HashType    UnitCount(const ActionID id, const UnitCountType count);
+    HashType    InProgress(const ActionID id, const FrameCountType finishFrame);
+    HashType    Building(const ActionID type, const ActionID constructing, const ActionID addon, const FrameCountType freeFrame);
+    HashType    Workers(const UnitCountType mineral, const UnitCountType gas, const UnitCountType building);
+    HashType    Larva(const UnitCountType numLarva);
+}
+}
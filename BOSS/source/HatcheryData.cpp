@@ -55,6 +55,12 @@ void HatcheryData::removeHatchery()
 
 void HatcheryData::fastForward(const FrameCountType & currentFrame, const FrameCountType & toFrame)
 {
+    // every hatchery spawns larva on the same frames, so if none of them fall in the time skipped there's nothing to do
+    if ((toFrame / Constants::ZERG_LARVA_TIMER) == (currentFrame / Constants::ZERG_LARVA_TIMER))
+    {
+        return;
+    }
+
     for (size_t i(0); i < _hatcheries.size(); ++i)
     {
         _hatcheries[i].fastForward(currentFrame, toFrame);
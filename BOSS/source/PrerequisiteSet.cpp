@@ -2,69 +2,63 @@
 
 using namespace BOSS;
 
-ActionCountPair::ActionCountPair()
-    : _count(0)
+PrerequisiteSet::PrerequisiteSet()
+    : _race(Races::None)
 {
 
 }
 
-ActionCountPair::ActionCountPair(const ActionType & action, const UnitCountType count)
-    : _action(action)
-    , _count(count)
+const size_t PrerequisiteSet::size() const
 {
+    return _actionIDs.size();
 }
 
-const ActionType & ActionCountPair::getAction() const
+const bool PrerequisiteSet::isEmpty() const
 {
-    return _action;
+    return _actionIDs.isEmpty();
 }
 
-const UnitCountType & ActionCountPair::getCount() const
+const bool PrerequisiteSet::contains(const ActionType & action) const
 {
-    return _count;       
+    return (action.getRace() == _race) && _actionIDs.contains(action.ID());
 }
 
-PrerequisiteSet::PrerequisiteSet()
+const ActionBitSet & PrerequisiteSet::getActionIDs() const
 {
-
+    return _actionIDs;
 }
 
-const size_t PrerequisiteSet::size() const
+ActionType PrerequisiteSet::getActionType(const UnitCountType index) const
 {
-    return _actionCounts.size();
-}
+    BOSS_ASSERT(index < size(), "PrerequisiteSet index out of bounds, Size = %d, Index = %d", (int)size(), (int)index);
 
-const bool PrerequisiteSet::isEmpty() const
-{
-    return size() == 0;
+    return ActionType(_race, (ActionID)_actionIDs.select(index));
 }
 
-const bool PrerequisiteSet::contains(const ActionType & action) const
+const UnitCountType PrerequisiteSet::getActionTypeCount(const UnitCountType index) const
 {
-    for (size_t i(0); i<_actionCounts.size(); ++i)
-    {
-        if (getActionType(i) == action)
-        {
-            return true;
-        }
-    }
-
-    return false;
+    return getCount(getActionType(index).ID());
 }
 
-const ActionType & PrerequisiteSet::getActionType(const UnitCountType index) const
+// the count of an action id which is in the set
+const UnitCountType PrerequisiteSet::getCount(const ActionID & id) const
 {
-    return _actionCounts[index].getAction();
+    return _counts[id];
 }
 
-const UnitCountType & PrerequisiteSet::getActionTypeCount(const UnitCountType index) const
-{
-    return _actionCounts[index].getCount();
-}
-    
+// adding an action which is already in the set keeps the larger of the two counts
 void PrerequisiteSet::add(const ActionType & action, const UnitCountType count)
 {
-    _actionCounts.push_back(ActionCountPair(action, count));
+    BOSS_ASSERT(isEmpty() || action.getRace() == _race, "Adding an action of a different race to a PrerequisiteSet");
+    BOSS_ASSERT(count <= std::numeric_limits<unsigned char>::max(), "Prerequisite count too large: %d", (int)count);
+
+    if (!contains(action) || _counts[action.ID()] < count)
+    {
+        _counts[action.ID()] = (unsigned char)count;
+    }
+
+    _race = action.getRace();
+    _actionIDs.add(action.ID());
 }
 
 void PrerequisiteSet::addUnique(const ActionType & action, const UnitCountType count)
@@ -85,27 +79,20 @@ void PrerequisiteSet::addUnique(const PrerequisiteSet & set)
 
 void PrerequisiteSet::remove(const ActionType & action)
 {
-    for (size_t i(0); i<_actionCounts.size(); ++i)
+    if (contains(action))
     {
-        if (_actionCounts[i].getAction() == action)
-        {
-            _actionCounts.remove(i);
-            return;
-        }
+        _actionIDs.remove(action.ID());
     }
 }
 
 void PrerequisiteSet::remove(const PrerequisiteSet & set)
 {
-    if (isEmpty())
+    if (isEmpty() || set._race != _race)
     {
         return;
     }
 
-    for (size_t i(0); i < set.size(); ++i)
-    {
-        remove(set.getActionType(i));
-    }
+    _actionIDs -= set._actionIDs;
 }
 
 const std::string PrerequisiteSet::toString() const
@@ -118,4 +105,4 @@ const std::string PrerequisiteSet::toString() const
     }
 
     return ss.str();
-}
\ No newline at end of file
+}
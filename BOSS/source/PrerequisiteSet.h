@@ -2,31 +2,20 @@
 
 #include "Common.h"
 #include "Constants.h"
-#include "Array.hpp"
+#include "ActionBitSet.hpp"
 #include "ActionType.h"
 
 namespace BOSS
 {
 
-class ActionCountPair
-{
-    ActionType      _action;
-    UnitCountType   _count;
-
-public:
-
-    ActionCountPair();
-
-    ActionCountPair(const ActionType & action, const UnitCountType count);
-
-    const ActionType & getAction() const;
-
-    const UnitCountType & getCount() const;
-};
-
+// a set of action types of one race with a required count for each
+// membership is a bitset of action ids and the counts are a dense array indexed by id,
+// so contains and add are constant time and index i is the i-th smallest id in the set
 class PrerequisiteSet
 {
-	Vec<ActionCountPair, Constants::MAX_ACTION_TYPES> _actionCounts;
+    ActionBitSet    _actionIDs;
+    unsigned char   _counts[Constants::MAX_ACTION_TYPES];
+    RaceID          _race;
 
 public:
 
@@ -35,8 +24,10 @@ public:
     const size_t size() const;
     const bool isEmpty() const;
     const bool contains(const ActionType & action) const;
-    const ActionType & getActionType(const UnitCountType index) const;
-    const UnitCountType & getActionTypeCount(const UnitCountType index) const;
+    const ActionBitSet & getActionIDs() const;
+    ActionType getActionType(const UnitCountType index) const;
+    const UnitCountType getActionTypeCount(const UnitCountType index) const;
+    const UnitCountType getCount(const ActionID & id) const;
     
     void add(const ActionType & action, const UnitCountType count = 1);
     void addUnique(const ActionType & action, const UnitCountType count = 1);
@@ -47,4 +38,4 @@ public:
     const std::string toString() const;
 };
 
-}
\ No newline at end of file
+}
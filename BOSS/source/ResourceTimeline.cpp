@@ -0,0 +1,142 @@
+#include "ResourceTimeline.h"
+
+using namespace BOSS;
+
+ResourceTimeline::ResourceTimeline()
+{
+
+}
+
+// the timeline belongs to one state's UnitData, so a copy builds its own when it's first asked
+ResourceTimeline::ResourceTimeline(const ResourceTimeline &)
+{
+
+}
+
+ResourceTimeline & ResourceTimeline::operator = (const ResourceTimeline &)
+{
+    clear();
+    return *this;
+}
+
+void ResourceTimeline::clear()
+{
+    _segments.clear();
+}
+
+// adds the segment that starts when the next action in progress not yet in the timeline finishes
+void ResourceTimeline::extend(const UnitData & units, const FrameCountType currentFrame)
+{
+    if (_segments.empty())
+    {
+        Segment first;
+        first.frame             = currentFrame;
+        first.minerals          = 0;
+        first.gas               = 0;
+        first.mineralWorkers    = units.getNumMineralWorkers();
+        first.gasWorkers        = units.getNumGasWorkers();
+        first.workersShort      = false;
+
+        _segments.push_back(first);
+        return;
+    }
+
+    // the actions in progress are sorted in descending order of finish time
+    const size_t numFinished = _segments.size() - 1;
+    BOSS_ASSERT(numFinished < units.getNumActionsInProgress(), "Every action in progress is already in the timeline");
+    const size_t progressIndex = units.getNumActionsInProgress() - numFinished - 1;
+
+    const Segment & last = _segments[_segments.size() - 1];
+    BOSS_ASSERT(!last.workersShort, "Not enough mineral workers");
+
+    const FrameCountType finishFrame = units.getFinishTimeByIndex(progressIndex);
+    const FrameCountType elapsed = finishFrame - last.frame;
+
+    Segment next;
+    next.frame              = finishFrame;
+    next.minerals           = last.minerals + elapsed * (ResourceCountType)(last.mineralWorkers * Constants::MPWPF);
+    next.gas                = last.gas + elapsed * (ResourceCountType)(last.gasWorkers * Constants::GPWPF);
+    next.mineralWorkers     = last.mineralWorkers;
+    next.gasWorkers         = last.gasWorkers;
+    next.workersShort       = false;
+
+    const ActionType & actionFinished = units.getActionInProgressByIndex(progressIndex);
+
+    // finishing a building as terran gives you a mineral worker back
+    if (actionFinished.isBuilding() && !actionFinished.isAddon() && (units.getRace() == Races::Terran))
+    {
+        next.mineralWorkers++;
+    }
+
+    if (actionFinished.isWorker())
+    {
+        next.mineralWorkers++;
+    }
+    else if (actionFinished.isRefinery())
+    {
+        // only a problem if a query needs the income after the refinery finishes, so it's checked when it does
+        next.workersShort = next.mineralWorkers <= 3;
+        next.mineralWorkers -= 3;
+        next.gasWorkers += 3;
+    }
+
+    _segments.push_back(next);
+}
+
+const FrameCountType ResourceTimeline::whenGathered(const UnitData & units, const FrameCountType currentFrame, const ResourceCountType amount, const bool gas)
+{
+    if (_segments.empty())
+    {
+        extend(units, currentFrame);
+    }
+
+    // add actions in progress until enough has been gathered by the start of the last segment, or there are none left
+    while (((gas ? _segments[_segments.size() - 1].gas : _segments[_segments.size() - 1].minerals) < amount) && (_segments.size() - 1 < units.getNumActionsInProgress()))
+    {
+        extend(units, currentFrame);
+    }
+
+    // the totals only ever go up, so binary search for the first segment that starts with enough gathered
+    // the amount is reached during the segment before it, or during the last one if none does
+    size_t low = 1;
+    size_t high = _segments.size();
+    while (low < high)
+    {
+        const size_t mid = (low + high) / 2;
+
+        if ((gas ? _segments[mid].gas : _segments[mid].minerals) >= amount)
+        {
+            high = mid;
+        }
+        else
+        {
+            low = mid + 1;
+        }
+    }
+
+    const Segment & segment = _segments[low - 1];
+    BOSS_ASSERT(!segment.workersShort, "Not enough mineral workers");
+
+    const ResourceCountType gathered = gas ? segment.gas : segment.minerals;
+    const ResourceCountType perFrame = gas ? (ResourceCountType)(segment.gasWorkers * Constants::GPWPF) : (ResourceCountType)(segment.mineralWorkers * Constants::MPWPF);
+
+    BOSS_ASSERT(perFrame > 0, "Shouldn't have 0 %s workers", gas ? "gas" : "mineral");
+
+    if (perFrame == 0)
+    {
+        return segment.frame + 1000000;
+    }
+
+    // round up, the amount has to be there on the frame we return
+    return segment.frame + (amount - gathered + perFrame - 1) / perFrame;
+}
+
+const FrameCountType ResourceTimeline::whenMineralsGathered(const UnitData & units, const FrameCountType currentFrame, const ResourceCountType minerals)
+{
+    return whenGathered(units, currentFrame, minerals, false);
+}
+
+const FrameCountType ResourceTimeline::whenGasGathered(const UnitData & units, const FrameCountType currentFrame, const ResourceCountType gas)
+{
+    return whenGathered(units, currentFrame, gas, true);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Common.h"
+#include "Array.hpp"
+#include "UnitData.h"
+
+namespace BOSS
+{
+
+// the minerals and gas a state will gather from its current frame onwards
+// income only changes when an action in progress finishes, so it's linear between the finish times and
+// the timeline keeps the total gathered at each one. asking when an amount will have been gathered is
+// then a binary search for the segment it's reached in and a division. actions in progress are folded
+// into the timeline as queries need them, so a query never walks further than the old simulation did
+//
+// the timeline is a cache of the state's UnitData and current frame, the owning GameState clears it
+// whenever either changes. copies start without one
+//
+// the GameState holds it mutable, so its const queries write to it. a GameState must not be queried
+// from several threads at once, give each thread its own copy
+class ResourceTimeline
+{
+    class Segment
+    {
+    public:
+
+        FrameCountType      frame;              // the frame the segment starts on
+        ResourceCountType   minerals;           // minerals gathered from the state's current frame until frame
+        ResourceCountType   gas;                // gas gathered from the state's current frame until frame
+        UnitCountType       mineralWorkers;     // workers gathering during the segment
+        UnitCountType       gasWorkers;
+        bool                workersShort;       // a refinery finished on frame without 3 mineral workers to put in it
+    };
+
+    Vec<Segment, Constants::MAX_PROGRESS + 1>   _segments;
+
+    void                    extend(const UnitData & units, const FrameCountType currentFrame);
+    const FrameCountType    whenGathered(const UnitData & units, const FrameCountType currentFrame, const ResourceCountType amount, const bool gas);
+
+public:
+
+    ResourceTimeline();
+    ResourceTimeline(const ResourceTimeline &);
+    ResourceTimeline & operator = (const ResourceTimeline &);
+
+    void                    clear();
+
+    // the first frame on which the given amount more than the state has now will have been gathered
+    const FrameCountType    whenMineralsGathered(const UnitData & units, const FrameCountType currentFrame, const ResourceCountType minerals);
+    const FrameCountType    whenGasGathered(const UnitData & units, const FrameCountType currentFrame, const ResourceCountType gas);
+};
+
+}
@@ -2,6 +2,25 @@
 
 using namespace BOSS;
 
+ProgressChange::ProgressChange(const int type, const ActionInProgress & action)
+    : _type(type)
+    , _action(action)
+{
+
+}
+
+UnitDataUndo::UnitDataUndo()
+    : _mineralWorkers(0)
+    , _gasWorkers(0)
+    , _buildingWorkers(0)
+    , _maxSupply(0)
+    , _currentSupply(0)
+    , _numBuildings(0)
+    , _buildingFrame(0)
+{
+
+}
+
 UnitData::UnitData(const RaceID race)
     : _race(race)
     , _numUnits(Constants::MAX_ACTIONS, 0)
@@ -161,12 +180,17 @@ void UnitData::removeCompletedAction(const ActionType & action)
 	}
 }
 
-void UnitData::addActionInProgress(const ActionType & action, const FrameCountType & completionFrame, bool queueAction)
+void UnitData::addActionInProgress(const ActionType & action, const FrameCountType & completionFrame, bool queueAction, UnitDataUndo * undo)
 {
     FrameCountType finishTime = (action.isBuilding() && !action.isMorphed()) ? completionFrame + Constants::BUILDING_PLACEMENT : completionFrame;
 
 	// add it to the actions in progress
 	_progress.addAction(action, finishTime);
+
+    if (undo)
+    {
+        undo->_progress.push_back(ProgressChange(ProgressChange::Started, ActionInProgress(action, finishTime)));
+    }
     
     if (!action.isMorphed())
     {
@@ -177,7 +201,7 @@ void UnitData::addActionInProgress(const ActionType & action, const FrameCountTy
 	{
 		// add it to a free building, which MUST be free since it's called from doAction
 		// which must be already fastForwarded to the correct time
-		_buildings.queueAction(action);
+		_buildings.queueAction(action, undo ? &undo->_buildings : nullptr);
 	}
 }
 
@@ -235,10 +259,15 @@ void UnitData::setBuildingWorkers(const UnitCountType & buildingWorkers)
     _buildingWorkers = buildingWorkers;
 }
 
-void UnitData::morphUnit(const ActionType & from, const ActionType & to, const FrameCountType & completionFrame)
+void UnitData::morphUnit(const ActionType & from, const ActionType & to, const FrameCountType & completionFrame, UnitDataUndo * undo)
 {
     BOSS_ASSERT(getNumCompleted(from) > 0, "Must have the unit type to morph it");
     _numUnits[from.ID()]--;
+
+    if (undo)
+    {
+        undo->_progress.push_back(ProgressChange(ProgressChange::Morphed, ActionInProgress(from, 0)));
+    }
     _currentSupply -= from.supplyRequired();
 
     if (from.isWorker())
@@ -247,7 +276,7 @@ void UnitData::morphUnit(const ActionType & from, const ActionType & to, const F
         _mineralWorkers--;
     }
 
-    addActionInProgress(to, completionFrame);
+    addActionInProgress(to, completionFrame, true, undo);
 }
 
 const UnitCountType UnitData::getNumMineralWorkers() const
@@ -265,11 +294,16 @@ const UnitCountType UnitData::getNumBuildingWorkers() const
     return _buildingWorkers;
 }
 
-ActionType UnitData::finishNextActionInProgress() 
+ActionType UnitData::finishNextActionInProgress(UnitDataUndo * undo) 
 {	
 	// get the actionUnit from the progress data
 	ActionType action = _progress.nextAction();
 
+    if (undo)
+    {
+        undo->_progress.push_back(ProgressChange(ProgressChange::Finished, ActionInProgress(action, _progress.nextActionFinishTime())));
+    }
+
 	// add the unit to the unit counter
 	addCompletedAction(action);
 			
@@ -303,9 +337,57 @@ const FrameCountType UnitData::getNextBuildingFinishTime() const
     return _progress.nextBuildingFinishTime();
 }
 
-void UnitData::setBuildingFrame(const FrameCountType & frame)
+void UnitData::setBuildingFrame(const FrameCountType & frame, UnitDataUndo * undo)
 {
-    _buildings.fastForwardBuildings(frame);
+    _buildings.fastForwardBuildings(frame, undo ? &undo->_buildings : nullptr);
+}
+
+void UnitData::saveUndo(UnitDataUndo & undo) const
+{
+    undo._mineralWorkers    = _mineralWorkers;
+    undo._gasWorkers        = _gasWorkers;
+    undo._buildingWorkers   = _buildingWorkers;
+    undo._maxSupply         = _maxSupply;
+    undo._currentSupply     = _currentSupply;
+    undo._hatcheryData      = _hatcheryData;
+    undo._numBuildings      = _buildings.size();
+    undo._buildingFrame     = _buildings.getCurrentFrame();
+    undo._progress.clear();
+    undo._buildings.clear();
+}
+
+// reverses the recorded changes last first, then puts back the saved counts
+// completed units and buildings are only ever added by finishing actions, so they are taken away with them
+void UnitData::undo(const UnitDataUndo & undo)
+{
+    for (size_t c(undo._progress.size()); c > 0; --c)
+    {
+        const ProgressChange & change = undo._progress[c-1];
+        const ActionType & action = change._action._action;
+
+        if (change._type == ProgressChange::Started)
+        {
+            _progress.removeAction(action, change._action._time);
+        }
+        else if (change._type == ProgressChange::Finished)
+        {
+            _numUnits[action.ID()] -= action.numProduced();
+            _progress.pushNextAction(change._action);
+        }
+        else
+        {
+            _numUnits[action.ID()]++;
+        }
+    }
+
+    _buildings.undoChanges(undo._buildings, undo._numBuildings, undo._buildingFrame);
+
+    _mineralWorkers     = undo._mineralWorkers;
+    _gasWorkers         = undo._gasWorkers;
+    _buildingWorkers    = undo._buildingWorkers;
+    _maxSupply          = undo._maxSupply;
+    _currentSupply      = undo._currentSupply;
+    _hatcheryData       = undo._hatcheryData;
 }
 
 const UnitCountType UnitData::getNumTotal(const ActionType & action) const
@@ -321,10 +403,12 @@ const bool UnitData::hasPrerequisites(const PrerequisiteSet & required) const
     static const ActionType & Spire         = ActionTypes::GetActionType("Zerg_Spire");
     static const ActionType & GreaterSpire  = ActionTypes::GetActionType("Zerg_Greater_Spire");
 
-    for (size_t a(0); a<required.size(); ++a)
+    const ActionBitSet & requiredIDs = required.getActionIDs();
+
+    for (size_t a(requiredIDs.next(0)); a < Constants::MAX_ACTION_TYPES; a = requiredIDs.next(a + 1))
     {
-        const ActionType & type = required.getActionType(a);
-        const size_t & req = required.getActionTypeCount(a);
+        const ActionType & type = ActionTypes::GetActionType(_race, (ActionID)a);
+        const size_t req = required.getCount((ActionID)a);
         size_t have = getNumTotal(type);
 
         // special check for zerg moprhed buildings
@@ -410,10 +494,11 @@ const FrameCountType UnitData::getFinishTime(const ActionType & action) const
 const PrerequisiteSet UnitData::getPrerequistesInProgress(const ActionType & action) const
 {
     PrerequisiteSet inProgress;
+    const ActionBitSet & prerequisites = action.getPrerequisiteIDs();
 
-    for (size_t a(0); a<action.getPrerequisites().size(); ++a)
+    for (size_t a(prerequisites.next(0)); a < Constants::MAX_ACTION_TYPES; a = prerequisites.next(a + 1))
     {
-        const ActionType & actionType = action.getPrerequisites().getActionType(a);
+        const ActionType & actionType = ActionTypes::GetActionType(_race, (ActionID)a);
         if (getNumInProgress(actionType) > 0 && getNumCompleted(actionType) == 0)
         {
             inProgress.add(actionType);
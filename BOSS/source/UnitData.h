@@ -10,6 +10,42 @@
 namespace BOSS
 {
 
+// an action that was started, finished or morphed from while doing actions, kept so UnitData::undo can reverse it
+class ProgressChange
+{
+public:
+
+    enum { Started, Finished, Morphed };
+
+    int                 _type;
+    ActionInProgress    _action;        // the action in progress, or the type morphed from with no time
+
+    ProgressChange(const int type, const ActionInProgress & action);
+};
+
+// what doing actions changed in a UnitData since UnitData::saveUndo
+// only the counts which change are saved, the actions and buildings which changed are recorded as they change
+class UnitDataUndo
+{
+    friend class UnitData;
+
+    UnitCountType                       _mineralWorkers;
+    UnitCountType                       _gasWorkers;
+    UnitCountType                       _buildingWorkers;
+    SupplyCountType                     _maxSupply;
+    SupplyCountType                     _currentSupply;
+    HatcheryData                        _hatcheryData;      // the larva of each hatchery
+    size_t                              _numBuildings;
+    FrameCountType                      _buildingFrame;
+
+    std::vector<ProgressChange>         _progress;
+    std::vector<BuildingChange>         _buildings;
+
+public:
+
+    UnitDataUndo();
+};
+
 class UnitData
 {
     RaceID                              _race;
@@ -71,14 +107,18 @@ public:
     void                    addCompletedBuilding(const ActionType & action, const FrameCountType timeUntilFree, const ActionType & constructing, const ActionType & addon, int numLarva);
     void                    addCompletedAction(const ActionType & action, bool wasBuilt = true);
 	void                    removeCompletedAction(const ActionType & action);
-    void                    addActionInProgress(const ActionType & action, const FrameCountType & completionFrame, bool queueAction = true);
-    void                    setBuildingFrame(const FrameCountType & frame);
+    void                    addActionInProgress(const ActionType & action, const FrameCountType & completionFrame, bool queueAction = true, UnitDataUndo * undo = nullptr);
+    void                    setBuildingFrame(const FrameCountType & frame, UnitDataUndo * undo = nullptr);
     void                    setMineralWorkers(const UnitCountType & mineralWorkers);
     void                    setGasWorkers(const UnitCountType & gasWorkers);
     void                    setBuildingWorkers(const UnitCountType & buildingWorkers);
-    void                    morphUnit(const ActionType & from, const ActionType & to, const FrameCountType & completionFrame);
+    void                    morphUnit(const ActionType & from, const ActionType & to, const FrameCountType & completionFrame, UnitDataUndo * undo = nullptr);
+
+    ActionType              finishNextActionInProgress(UnitDataUndo * undo = nullptr);
 
-    ActionType              finishNextActionInProgress();
+    // the functions above which take an undo record their changes in it, undo reverses them
+    void                    saveUndo(UnitDataUndo & undo) const;
+    void                    undo(const UnitDataUndo & undo);
 
     const BuildingData &    getBuildingData() const;
     const HatcheryData &    getHatcheryData() const;
@@ -0,0 +1,208 @@
+#include "../BOSS.h"
+
+using namespace BOSS;
+
+// times the build order simulation hot paths on fixed reference states
+// output is one CSV row per benchmark and state so runs can be diffed or plotted:
+//
+//   engine,benchmark,state,ops,ms,ns_per_op
+//
+// usage: BOSSBenchmark [MinMSPerBenchmark]
+
+namespace
+{
+    // results are folded into this so the compiler can't drop the work being timed
+    size_t sink(0);
+
+    // runs f in doubling batches until at least minMS has passed, then prints the average time per op
+    // f performs opsPerCall operations each time it is called
+    template <class F>
+    void runBenchmark(const std::string & name, const std::string & stateName, const double & minMS, const size_t & opsPerCall, F & f)
+    {
+        size_t iterations(0);
+        size_t batch(1);
+
+        Timer t;
+        t.start();
+
+        while (true)
+        {
+            for (size_t i(0); i < batch; ++i)
+            {
+                f();
+            }
+
+            iterations += batch;
+
+            if (t.getElapsedTimeInMilliSec() >= minMS)
+            {
+                break;
+            }
+
+            batch *= 2;
+        }
+
+        const double ms(t.getElapsedTimeInMilliSec());
+        const size_t ops(iterations * std::max(opsPerCall, (size_t)1));
+        printf("BOSS,%s,%s,%lu,%.3lf,%.1lf\n", name.c_str(), stateName.c_str(), (unsigned long)ops, ms, 1000000.0 * ms / ops);
+        fflush(stdout);
+    }
+
+    // the starting state of a race followed by the given build order
+    GameState getReferenceState(const RaceID race, const std::vector<std::string> & buildOrder)
+    {
+        GameState state(race);
+        state.setStartingState();
+
+        for (size_t a(0); a < buildOrder.size(); ++a)
+        {
+            const ActionType & action(ActionTypes::GetActionType(buildOrder[a]));
+            BOSS_ASSERT(state.isLegal(action), "Reference build order action is not legal: %s", buildOrder[a].c_str());
+
+            state.doAction(action);
+        }
+
+        return state;
+    }
+
+    // a protoss state with more production buildings than an opening, half of them busy
+    // so that work done per building rather than per event shows up
+    GameState getLateGameState()
+    {
+        GameState state(Races::Protoss);
+        state.setStartingState();
+
+        state.addCompletedAction(ActionTypes::GetActionType("Protoss_Pylon"), 12);
+        state.addCompletedAction(ActionTypes::GetActionType("Protoss_Probe"), 26);
+        state.addCompletedAction(ActionTypes::GetActionType("Protoss_Gateway"), 40);
+        state.addCompletedAction(ActionTypes::GetActionType("Protoss_Cybernetics_Core"), 1);
+        state.setMinerals(3000);
+
+        const ActionType & zealot(ActionTypes::GetActionType("Protoss_Zealot"));
+        for (size_t z(0); z < 20; ++z)
+        {
+            BOSS_ASSERT(state.isLegal(zealot), "Late game reference zealot is not legal");
+            state.doAction(zealot);
+        }
+
+        return state;
+    }
+
+    void runStateBenchmarks(const std::string & stateName, const GameState & state, const BuildOrderSearchGoal & goal, const double & minMS)
+    {
+        const RaceID race(state.getRace());
+        const std::vector<ActionType> & allActions(ActionTypes::GetAllActionTypes(race));
+
+        ActionSet legalActions;
+        state.getAllLegalActions(legalActions);
+
+        // a worker where possible, otherwise whatever is legal first
+        const ActionType & worker(ActionTypes::GetWorker(race));
+        const ActionType nextAction(state.isLegal(worker) ? worker : legalActions[0]);
+
+        auto doAction = [&]()
+        {
+            GameState child(state);
+            child.doAction(nextAction);
+            sink += child.getCurrentFrame();
+        };
+        runBenchmark("doAction(includes copy)", stateName, minMS, 1, doAction);
+
+        auto whenCanPerform = [&]()
+        {
+            for (size_t a(0); a < legalActions.size(); ++a)
+            {
+                sink += state.whenCanPerform(legalActions[a]);
+            }
+        };
+        runBenchmark("whenCanPerform", stateName, minMS, legalActions.size(), whenCanPerform);
+
+        auto isLegal = [&]()
+        {
+            for (size_t a(0); a < allActions.size(); ++a)
+            {
+                sink += state.isLegal(allActions[a]);
+            }
+        };
+        runBenchmark("isLegal", stateName, minMS, allActions.size(), isLegal);
+
+        auto fastForward = [&]()
+        {
+            GameState child(state);
+            child.fastForward(state.getCurrentFrame() + 1000);
+            sink += child.getMinerals();
+        };
+        runBenchmark("fastForward(includes copy)", stateName, minMS, 1, fastForward);
+
+        auto lowerBound = [&]()
+        {
+            sink += Tools::GetLowerBound(state, goal);
+        };
+        runBenchmark("GetLowerBound", stateName, minMS, 1, lowerBound);
+
+        DFBB_LowerBound dfbbBound(goal);
+        auto dfbbLowerBound = [&]()
+        {
+            sink += dfbbBound.getLowerBound(state);
+        };
+        runBenchmark("DFBB_LowerBound", stateName, minMS, 1, dfbbLowerBound);
+    }
+
+    BuildOrderSearchGoal getGoal(const RaceID race, const std::vector<std::pair<std::string, UnitCountType> > & units)
+    {
+        BuildOrderSearchGoal goal(race);
+
+        for (size_t u(0); u < units.size(); ++u)
+        {
+            goal.setGoal(ActionTypes::GetActionType(units[u].first), units[u].second);
+        }
+
+        return goal;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    BOSS::init();
+
+    const double minMS(argc > 1 ? atof(argv[1]) : 1000);
+
+    printf("engine,benchmark,state,ops,ms,ns_per_op\n");
+
+    std::vector<std::pair<std::string, UnitCountType> > protossGoal;
+    protossGoal.push_back(std::make_pair("Protoss_Dragoon", 4));
+    protossGoal.push_back(std::make_pair("Protoss_Zealot", 2));
+
+    std::vector<std::pair<std::string, UnitCountType> > terranGoal;
+    terranGoal.push_back(std::make_pair("Terran_Marine", 8));
+    terranGoal.push_back(std::make_pair("Terran_Vulture", 2));
+
+    std::vector<std::pair<std::string, UnitCountType> > zergGoal;
+    zergGoal.push_back(std::make_pair("Zerg_Zergling", 12));
+    zergGoal.push_back(std::make_pair("Zerg_Hydralisk", 4));
+
+    std::vector<std::string> protossOpening;
+    const char * protossBuild[] = { "Protoss_Probe", "Protoss_Probe", "Protoss_Probe", "Protoss_Probe", "Protoss_Pylon", "Protoss_Probe", "Protoss_Probe",
+                                    "Protoss_Gateway", "Protoss_Probe", "Protoss_Assimilator", "Protoss_Probe", "Protoss_Cybernetics_Core", "Protoss_Probe", "Protoss_Pylon" };
+    protossOpening.assign(protossBuild, protossBuild + sizeof(protossBuild) / sizeof(protossBuild[0]));
+
+    std::vector<std::string> terranOpening;
+    const char * terranBuild[] = { "Terran_SCV", "Terran_SCV", "Terran_SCV", "Terran_SCV", "Terran_Supply_Depot", "Terran_SCV", "Terran_SCV",
+                                   "Terran_Barracks", "Terran_SCV", "Terran_Refinery", "Terran_SCV", "Terran_Marine", "Terran_SCV", "Terran_Supply_Depot" };
+    terranOpening.assign(terranBuild, terranBuild + sizeof(terranBuild) / sizeof(terranBuild[0]));
+
+    std::vector<std::string> zergOpening;
+    const char * zergBuild[] = { "Zerg_Drone", "Zerg_Drone", "Zerg_Drone", "Zerg_Drone", "Zerg_Drone", "Zerg_Overlord", "Zerg_Spawning_Pool",
+                                 "Zerg_Drone", "Zerg_Drone", "Zerg_Extractor", "Zerg_Drone", "Zerg_Zergling", "Zerg_Drone" };
+    zergOpening.assign(zergBuild, zergBuild + sizeof(zergBuild) / sizeof(zergBuild[0]));
+
+    runStateBenchmarks("protossStart",   getReferenceState(Races::Protoss, std::vector<std::string>()), getGoal(Races::Protoss, protossGoal), minMS);
+    runStateBenchmarks("protossOpening", getReferenceState(Races::Protoss, protossOpening),             getGoal(Races::Protoss, protossGoal), minMS);
+    runStateBenchmarks("terranOpening",  getReferenceState(Races::Terran,  terranOpening),              getGoal(Races::Terran,  terranGoal),  minMS);
+    runStateBenchmarks("zergOpening",    getReferenceState(Races::Zerg,    zergOpening),                getGoal(Races::Zerg,    zergGoal),    minMS);
+    runStateBenchmarks("protossLateGame", getLateGameState(),                                          getGoal(Races::Protoss, protossGoal), minMS);
+
+    fprintf(stderr, "checksum %lu\n", (unsigned long)sink);
+
+    return 0;
+}
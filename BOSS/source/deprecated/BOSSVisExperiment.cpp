@@ -380,7 +380,7 @@ PositionType BOSSVisExperiment::DrawScenario(const Position & pos, const size_t
         const BuildingStatus & buildingStatus = buildingData.getBuilding(i);
 
         const ActionType & type = buildingStatus._type;
-        const FrameCountType & finishTime = buildingStatus._timeRemaining;
+        const FrameCountType finishTime = buildingData.getTimeUntilFree(i);
         const ActionType & makingType = buildingStatus._isConstructing;
 
         GUITools::DrawRect(buildings + progressBuffer, buildings + progressBuffer + progressBar, white);
@@ -30,7 +30,7 @@ Action::Action( const IDType & unitIndex, const IDType & player, const IDType &
 		
 }
 
-const bool Action::operator == (const Action & rhs)
+const bool Action::operator == (const Action & rhs) const
 {
 	return _unit == rhs._unit && _player == rhs._player && _moveType == rhs._moveType && _moveIndex == rhs._moveIndex && _p == rhs._p;
 }
@@ -29,7 +29,7 @@ public:
 
 	Action( const IDType & unitIndex, const IDType & player, const IDType & type, const IDType & moveIndex);
 
-	const bool operator == (const Action & rhs);
+	const bool operator == (const Action & rhs) const;
 
 	const IDType & unit()	const;
 	const IDType & player() const;
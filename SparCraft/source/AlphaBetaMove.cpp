@@ -4,12 +4,23 @@ using namespace SparCraft;
 
 AlphaBetaMove::AlphaBetaMove()
     : _isValid(false)
+    , _index(0)
+    , _check(0)
 {
 }
 
-AlphaBetaMove::AlphaBetaMove(const std::vector<Action> & move,const bool & isValid)
+AlphaBetaMove::AlphaBetaMove(const std::vector<Action> & move,const bool & isValid, const size_t & index)
     : _move(move)
     ,_isValid(isValid)
+    ,_index(index)
+    ,_check(getCheck(move))
+{
+}
+
+AlphaBetaMove::AlphaBetaMove(const size_t & index, const unsigned char & check)
+    : _isValid(true)
+    ,_index(index)
+    ,_check(check)
 {
 }
 
@@ -23,6 +34,30 @@ const std::vector<Action> & AlphaBetaMove::moveVec() const
     return _move; 
 }
 
+const size_t & AlphaBetaMove::index() const 
+{ 
+    return _index; 
+}
+
+const unsigned char & AlphaBetaMove::check() const 
+{ 
+    return _check; 
+}
+
+// a byte hashed from every action of the move, used to tell whether the child found at a stored index is still the same move
+const unsigned char AlphaBetaMove::getCheck(const std::vector<Action> & move)
+{
+    unsigned int hash(0);
+
+    for (size_t a(0); a<move.size(); ++a)
+    {
+        const unsigned int action = move[a].unit() | (move[a].type() << 8) | (move[a].index() << 16) | (move[a].player() << 24);
+        hash = (hash ^ action) * 0x9E3779B1u;
+    }
+
+    return (unsigned char)(hash >> 24);
+}
+
 TTBestMove::TTBestMove()
 {
 }
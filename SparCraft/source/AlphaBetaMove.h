@@ -7,19 +7,29 @@
 namespace SparCraft
 {
 
+// a move vector along with where it was found among the children of its node
+// the transposition table only keeps the index and a check byte of a move, a move read back
+// from the table has no move vector until it is found again among the node's children
 class AlphaBetaMove
 {
 	std::vector<Action> _move;
 	bool _isValid;
+	size_t _index;
+	unsigned char _check;
 
 public:
 
 	AlphaBetaMove();
 
-	AlphaBetaMove(const std::vector<Action> & move, const bool & isValid);
+	AlphaBetaMove(const std::vector<Action> & move, const bool & isValid, const size_t & index = 0);
+	AlphaBetaMove(const size_t & index, const unsigned char & check);
 
 	const bool isValid() const;
 	const std::vector<Action> & moveVec() const;
+	const size_t & index() const;
+	const unsigned char & check() const;
+
+	static const unsigned char getCheck(const std::vector<Action> & move);
 };
 
 class TTBestMove
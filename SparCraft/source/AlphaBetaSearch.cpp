@@ -5,7 +5,8 @@ using namespace SparCraft;
 AlphaBetaSearch::AlphaBetaSearch(const AlphaBetaSearchParameters & params, TTPtr TT) 
 	: _params(params)
 	, _currentRootDepth(0)
-	, _TT(TT ? TT : TTPtr(new TranspositionTable()))
+	, _TT(TT ? TT : TTPtr(new TranspositionTable(params.ttSizeMB())))
+	, _stopSearch(NULL)
 {
     for (size_t p(0); p<Constants::Num_Players; ++p)
     {
@@ -26,6 +27,15 @@ AlphaBetaSearch::AlphaBetaSearch(const AlphaBetaSearchParameters & params, TTPtr
 void AlphaBetaSearch::doSearch(GameState & initialState)
 {
 	_searchTimer.start();
+	_results.ttStats = TTStats();
+	_results.cutoffs = 0;
+	_results.firstChildCutoffs = 0;
+	_TT->newSearch();
+
+	if (useHistory())
+	{
+		_history.newSearch();
+	}
 
 	StateEvalScore alpha(-10000000, 1000000);
 	StateEvalScore beta	( 10000000, 1000000);
@@ -34,23 +44,91 @@ void AlphaBetaSearch::doSearch(GameState & initialState)
 
 	if (_params.searchMethod() == SearchMethods::AlphaBeta)
 	{
+		_currentRootDepth = _params.maxDepth();
 		val = alphaBeta(initialState, _params.maxDepth(), Players::Player_None, NULL, alpha, beta);
 	}
 	else if (_params.searchMethod() == SearchMethods::IDAlphaBeta)
 	{
-		val = IDAlphaBeta(initialState, _params.maxDepth());
+		if (_params.numThreads() > 1)
+		{
+			val = lazySMPSearch(initialState, _params.maxDepth());
+		}
+		else
+		{
+			val = IDAlphaBeta(initialState, _params.maxDepth());
+			_results.totalNodesExpanded = _results.nodesExpanded;
+		}
 	}
 
 	_results.timeElapsed = _searchTimer.getElapsedTimeInMilliSec();
 }
 
-AlphaBetaValue AlphaBetaSearch::IDAlphaBeta(GameState & initialState, const size_t & maxDepth)
+void AlphaBetaSearch::setSeed(const unsigned long long & seed)
+{
+	_random.seed(seed);
+}
+
+// Lazy SMP: helper threads run their own iterative deepening on the same root, sharing only the TT
+// the entries they leave behind make the main thread's search cheaper, only its result is reported
+AlphaBetaValue AlphaBetaSearch::lazySMPSearch(GameState & initialState, const size_t & maxDepth)
+{
+	std::atomic<bool> stopSearch(false);
+	std::vector< std::shared_ptr<AlphaBetaSearch> > helpers;
+	std::vector<GameState> helperStates(_params.numThreads() - 1, initialState);
+	std::vector<std::thread> threads;
+
+	AlphaBetaSearchParameters helperParams(_params);
+	helperParams.setNumThreads(1);
+	helperParams.setTimeLimit(0);
+
+	for (size_t t(0); t < helperStates.size(); ++t)
+	{
+		helpers.push_back(std::shared_ptr<AlphaBetaSearch>(new AlphaBetaSearch(helperParams, _TT)));
+		helpers[t]->_stopSearch = &stopSearch;
+		helpers[t]->setSeed(_random.next());
+
+		if (useHistory())
+		{
+			helpers[t]->_history.newSearch();
+		}
+		helpers[t]->_searchTimer.start();
+	}
+
+	for (size_t t(0); t < helpers.size(); ++t)
+	{
+		// stagger the helpers so that half of them are always a ply ahead of the main thread
+		AlphaBetaSearch * helper = helpers[t].get();
+		GameState * helperState = &helperStates[t];
+		const size_t startDepth = 1 + (t % 2);
+
+		threads.push_back(std::thread([helper, helperState, startDepth, maxDepth]()
+		{
+			helper->IDAlphaBeta(*helperState, maxDepth, startDepth);
+		}));
+	}
+
+	AlphaBetaValue val = IDAlphaBeta(initialState, maxDepth);
+
+	stopSearch = true;
+	_results.totalNodesExpanded = _results.nodesExpanded;
+
+	for (size_t t(0); t < threads.size(); ++t)
+	{
+		threads[t].join();
+		_results.totalNodesExpanded += helpers[t]->getResults().nodesExpanded;
+		_results.ttStats.add(helpers[t]->getResults().ttStats);
+	}
+
+	return val;
+}
+
+AlphaBetaValue AlphaBetaSearch::IDAlphaBeta(GameState & initialState, const size_t & maxDepth, const size_t & startDepth)
 {
 	AlphaBetaValue val;
 	_results.nodesExpanded = 0;
 	_results.maxDepthReached = 0;
 
-	for (size_t d(1); d < maxDepth; ++d)
+	for (size_t d(startDepth); d < maxDepth; ++d)
 	{
 		
 		StateEvalScore alpha(-10000000, 999999);
@@ -73,7 +151,7 @@ AlphaBetaValue AlphaBetaSearch::IDAlphaBeta(GameState & initialState, const size
 			e += 1;
 
 			// if we didn't finish the first depth, set the move to the best script move
-			if (d == 1)
+			if (d == startDepth)
 			{
 				MoveArray moves;
 				const IDType playerToMove(getPlayerToMove(initialState, 1, Players::Player_None, true));
@@ -89,7 +167,7 @@ AlphaBetaValue AlphaBetaSearch::IDAlphaBeta(GameState & initialState, const size
 		double ms = _searchTimer.getElapsedTimeInMilliSec();
 
 		//printTTResults();
-		//fprintf(stdout, "%s %8d %9d %9d %13.4lf %14llu %12d %12llu %15.2lf\n", "IDA", d, val.score().val(), (int)val.abMove().moveTuple(), ms, nodes, (int)_TT->numFound(), getResults().ttcuts, 1000*nodes/ms);
+		//fprintf(stdout, "%s %8d %9d %9d %13.4lf %14llu %12d %12llu %15.2lf\n", "IDA", d, val.score().val(), (int)val.abMove().moveTuple(), ms, nodes, (int)_results.ttStats.found, getResults().ttcuts, 1000*nodes/ms);
 	}
 
 	return val;
@@ -100,9 +178,9 @@ void AlphaBetaSearch::TTsave(	GameState & state, const StateEvalScore & value, c
 						const IDType & firstPlayer, const AlphaBetaMove & bestFirstMove, const AlphaBetaMove & bestSecondMove) 
 {
 	// IF THE DEPTH OF THE ENTRY IS BIGGER THAN CURRENT DEPTH, DO NOTHING
-	TTEntry * entry = _TT->lookupScan(state.calculateHash(0), state.calculateHash(1));
-	bool valid = entry && entry->isValid();
-	size_t edepth = entry ? entry->getDepth() : 0;
+	TTEntry entry;
+	bool valid = _TT->lookup(state.calculateHash(0), state.calculateHash(1), entry, _results.ttStats);
+	size_t edepth = valid ? entry.getDepth() : 0;
 
 	_results.ttSaveAttempts++;
 	
@@ -117,28 +195,32 @@ void AlphaBetaSearch::TTsave(	GameState & state, const StateEvalScore & value, c
 	else if (value >= beta)  type = TTEntry::LOWER;
 	else                     type = TTEntry::ACCURATE;
 
+	// the number of moves is saved counting from this state, the game's total keeps growing past what an entry holds
+	const StateEvalScore saved(value.val(), value.numMoves() - state.getNumMovements(_params.maxPlayer()));
+
 	// SAVE A NEW ENTRY IN THE TRANSPOSITION TABLE
-	_TT->save(state.calculateHash(0), state.calculateHash(1), value, depth, type, firstPlayer, bestFirstMove, bestSecondMove);
+	_TT->save(state.calculateHash(0), state.calculateHash(1), saved, depth, type, firstPlayer, bestFirstMove, bestSecondMove, _results.ttStats);
 }
 
 // Transposition Table look up + alpha/beta update
 TTLookupValue AlphaBetaSearch::TTlookup(const GameState & state, StateEvalScore & alpha, StateEvalScore & beta, const size_t & depth)
 {
-	TTEntry * entry = _TT->lookupScan(state.calculateHash(0), state.calculateHash(1));
-	if (entry && (entry->getDepth() == depth)) 
+	TTEntry entry;
+	const bool found = _TT->lookup(state.calculateHash(0), state.calculateHash(1), entry, _results.ttStats);
+	if (found && (entry.getDepth() == depth)) 
 	{
-		// get the value and type of the entry
-		StateEvalScore TTvalue = entry->getScore();
+		// get the value and type of the entry, counting its moves from the start of the game like the search does
+		StateEvalScore TTvalue(entry.getScore().val(), entry.getScore().numMoves() + state.getNumMovements(_params.maxPlayer()));
 		
 		// set alpha and beta depending on the type of entry in the TT
-		if (entry->getType() == TTEntry::LOWER)
+		if (entry.getType() == TTEntry::LOWER)
 		{
 			if (TTvalue > alpha) 
 			{
 				alpha = TTvalue;
 			}
 		}
-		else if (entry->getType() == TTEntry::UPPER) 
+		else if (entry.getType() == TTEntry::UPPER) 
 		{
 			if (TTvalue < beta)
 			{
@@ -156,16 +238,16 @@ TTLookupValue AlphaBetaSearch::TTlookup(const GameState & state, StateEvalScore
 		{
 			// this will be a cut
 			_results.ttcuts++;
-			return TTLookupValue(true, true, entry);
+			return TTLookupValue(true, true, entry, TTvalue);
 		}
 		else
 		{
 			// found but no cut
 			_results.ttFoundNoCut++;
-			return TTLookupValue(true, false, entry);
+			return TTLookupValue(true, false, entry, TTvalue);
 		}
 	}
-	else if (entry)
+	else if (found)
 	{
 		_results.ttFoundLessDepth++;
 		return TTLookupValue(true, false, entry);
@@ -176,7 +258,8 @@ TTLookupValue AlphaBetaSearch::TTlookup(const GameState & state, StateEvalScore
 
 const bool AlphaBetaSearch::searchTimeOut()
 {
-	return (_params.timeLimit() && (_results.nodesExpanded % 50 == 0) && (_searchTimer.getElapsedTimeInMilliSec() >= _params.timeLimit()));
+	return (_stopSearch && _stopSearch->load(std::memory_order_relaxed))
+		|| (_params.timeLimit() && (_results.nodesExpanded % 50 == 0) && (_searchTimer.getElapsedTimeInMilliSec() >= _params.timeLimit()));
 }
 
 const bool AlphaBetaSearch::terminalState(GameState & state, const size_t & depth) const
@@ -184,22 +267,6 @@ const bool AlphaBetaSearch::terminalState(GameState & state, const size_t & dept
 	return (depth <= 0 || state.isTerminal());
 }
 
-const AlphaBetaMove & AlphaBetaSearch::getAlphaBetaMove(const TTLookupValue & TTval, const IDType & playerToMove) const
-{
-	const IDType enemyPlayer(getEnemy(playerToMove));
-
-	// if we have a valid first move for this player, use it
-	if (TTval.entry()->getBestMove(playerToMove).firstMove().isValid())
-	{
-		return TTval.entry()->getBestMove(playerToMove).firstMove();
-	}
-	// otherwise return the response to an opponent move, if it doesn't exist it will just be invalid
-	else
-	{
-		return TTval.entry()->getBestMove(enemyPlayer).secondMove();
-	}
-}
-
 void AlphaBetaSearch::generateOrderedMoves(GameState & state, MoveArray & moves, const TTLookupValue & TTval, const IDType & playerToMove, const size_t & depth)
 {
 	// get the array where we will store the moves and clear it
@@ -218,37 +285,13 @@ void AlphaBetaSearch::generateOrderedMoves(GameState & state, MoveArray & moves,
 		return;
 	}
 
-	// if there is a transposition table entry for this state
-	/*if (TTval.found())
-	{
-		// get the abMove we stored for this player
-		const AlphaBetaMove & abMove = getAlphaBetaMove(TTval, playerToMove);
-
-		_results.ttFoundCheck++;
-
-		// Two checks:
-		// 1) Is the move 'valid' ie: was it actually set inside the TT
-		// TODO:: Possibly validate this move a second time somehow
-        //        Was previously done with move tuple numbers
-		if (abMove.isValid())
-		{
-			orderedMoves.add(abMove.moveVec());
-			_results.ttMoveOrders++;
-			return;
-		}
-		else
-		{
-			_results.ttFoundButNoMove++;
-		}
-	}*/
-
     if (depth == 2)
     {
         int a = 6;
     }
 
     // if we are using script move ordering, insert the script moves we want
-    if (_params.moveOrderingMethod() == MoveOrderMethod::ScriptFirst)
+    if ((_params.moveOrderingMethod() == MoveOrderMethod::ScriptFirst) || useHistory())
     {
         for (size_t s(0); s<_params.getOrderedMoveScripts().size(); s++)
 	    {
@@ -262,9 +305,68 @@ void AlphaBetaSearch::generateOrderedMoves(GameState & state, MoveArray & moves,
             int a = 6;
         }
     }
+
+    // the rest of the children come from the move iterator, which will now try killer and history actions first
+    if (useHistory())
+    {
+        const size_t ply(_currentRootDepth - depth);
+        auto moveScore = [this, &state, ply](const Action & move) { return _history.getScore(state, move, ply); };
+        moves.sortMoves(moveScore);
+    }
+}
+
+// finds the best move the TT stored for this player among the node's children again
+// children are numbered in the order getNextMoveVec returns them: the ordered moves, then the move iterator
+// the move is only used if its check byte still matches, the shuffle and history sort change the iterator's order between visits
+AlphaBetaMove AlphaBetaSearch::getTTMove(MoveArray & moves, const TTLookupValue & TTval, const IDType & playerToMove, const size_t & depth)
+{
+	if (!TTval.found() || (_params.playerModel(playerToMove) != PlayerModels::None))
+	{
+		return AlphaBetaMove();
+	}
+
+	_results.ttFoundCheck++;
+
+	const AlphaBetaMove ttMove = TTval.entry().getBestMove(playerToMove);
+	const Array<std::vector<Action>, Constants::Max_Ordered_Moves> & orderedMoves(_orderedMoves[depth]);
+	std::vector<Action> moveVec;
+
+	if (ttMove.isValid())
+	{
+		if (ttMove.index() < orderedMoves.size())
+		{
+			moveVec = orderedMoves[ttMove.index()];
+		}
+		else
+		{
+			for (size_t i(orderedMoves.size()); (i < ttMove.index()) && moves.hasMoreMoves(); ++i)
+			{
+				moves.incrementMove(0);
+			}
+
+			if (moves.hasMoreMoves())
+			{
+				moves.getNextMoveVec(moveVec);
+			}
+
+			moves.resetMoveIterator();
+		}
+	}
+
+	if (moveVec.empty() || (AlphaBetaMove::getCheck(moveVec) != ttMove.check()))
+	{
+		_results.ttFoundButNoMove++;
+		return AlphaBetaMove();
+	}
+
+	_results.ttMoveOrders++;
+	return AlphaBetaMove(moveVec, true, ttMove.index());
 }
 
-bool AlphaBetaSearch::getNextMoveVec(IDType playerToMove, MoveArray & moves, const size_t & moveNumber, const TTLookupValue & TTval, const size_t & depth, std::vector<Action> & moveVec) const
+// returns the next child to search and its index in the node's child order
+// the TT move is searched first and skipped when the other children reach its index
+bool AlphaBetaSearch::getNextMoveVec(IDType playerToMove, MoveArray & moves, const size_t & moveNumber, size_t & nextChild, const AlphaBetaMove & ttMove, 
+									 const TTLookupValue & TTval, const size_t & depth, std::vector<Action> & moveVec, size_t & moveIndex) const
 {
     if (_params.maxChildren() && (moveNumber >= _params.maxChildren()))
     {
@@ -281,26 +383,41 @@ bool AlphaBetaSearch::getNextMoveVec(IDType playerToMove, MoveArray & moves, con
 		    return false;
 	    }
 
-	    // if there is a transposition table entry for this state
-	    if (TTval.found())
-	    {
-		    // if there was a valid move found with higher depth, just do that one
-		    const AlphaBetaMove & abMove = getAlphaBetaMove(TTval, playerToMove);
-		    if ((TTval.entry()->getDepth() >= depth) && abMove.isValid())
-		    {
-                // so return false
-			    return false;
-		    }
-	    }
+		// if the TT move was searched first and found with higher depth, just do that one
+		if (ttMove.isValid() && (TTval.entry().getDepth() >= depth))
+		{
+			return false;
+		}
     }
 
+	if ((moveNumber == 0) && ttMove.isValid())
+	{
+		moveVec.assign(ttMove.moveVec().begin(), ttMove.moveVec().end());
+		moveIndex = ttMove.index();
+		return true;
+	}
+
 	const Array<std::vector<Action>, Constants::Max_Ordered_Moves> & orderedMoves(_orderedMoves[depth]);
+
+	// skip the TT move's own place in the order, the child with its index is the move already searched
+	if (ttMove.isValid() && (nextChild == ttMove.index()))
+	{
+		if ((nextChild >= orderedMoves.size()) && moves.hasMoreMoves())
+		{
+			moves.getNextMoveVec(moveVec);
+		}
+
+		nextChild++;
+	}
+
     moveVec.clear();
+	moveIndex = nextChild;
    
 	// if this move should be from the ordered list, return it from the list
-	if (moveNumber < orderedMoves.size())
+	if (nextChild < orderedMoves.size())
 	{
-        moveVec.assign(orderedMoves[moveNumber].begin(), orderedMoves[moveNumber].end());
+        moveVec.assign(orderedMoves[nextChild].begin(), orderedMoves[nextChild].end());
+		nextChild++;
         return true;
 	}
 	// otherwise return the next move vector starting from the beginning
@@ -309,6 +426,7 @@ bool AlphaBetaSearch::getNextMoveVec(IDType playerToMove, MoveArray & moves, con
         if (moves.hasMoreMoves())
         {
             moves.getNextMoveVec(moveVec);
+			nextChild++;
             return true;
         }
         else
@@ -318,7 +436,7 @@ bool AlphaBetaSearch::getNextMoveVec(IDType playerToMove, MoveArray & moves, con
 	}
 }
 
-const IDType AlphaBetaSearch::getPlayerToMove(GameState & state, const size_t & depth, const IDType & lastPlayerToMove, const bool isFirstSimMove) const
+const IDType AlphaBetaSearch::getPlayerToMove(GameState & state, const size_t & depth, const IDType & lastPlayerToMove, const bool isFirstSimMove)
 {
 	const IDType whoCanMove(state.whoCanMove());
 
@@ -345,8 +463,7 @@ const IDType AlphaBetaSearch::getPlayerToMove(GameState & state, const size_t &
 		}
 		else if (policy == SparCraft::PlayerToMove::Random)
 		{
-			// srand(state.calculateHash(0));
-			return isRoot(depth) ? maxPlayer : rand() % 2;
+			return isRoot(depth) ? maxPlayer : _random.nextInt(2);
 		}
 
 		// we should never get to this state
@@ -392,12 +509,22 @@ AlphaBetaValue AlphaBetaSearch::alphaBeta(GameState & state, size_t depth, const
 	TTLookupValue TTval;
 	if (isTranspositionLookupState(state, prevSimMove))
 	{
-		TTval = TTlookup(state, alpha, beta, depth);
-
-		// if this is a TT cut, return the proper value
-		if (TTval.cut())
+		// the root never cuts, the entry only knows its best move by child index and check byte, which can
+		// match a different move once the children are shuffled and sorted differently, so it's only used for ordering
+		if (isRoot(depth))
+		{
+			StateEvalScore rootAlpha(alpha), rootBeta(beta);
+			TTval = TTlookup(state, rootAlpha, rootBeta, depth);
+		}
+		else
 		{
-			return AlphaBetaValue(TTval.entry()->getScore(), getAlphaBetaMove(TTval, playerToMove));
+			TTval = TTlookup(state, alpha, beta, depth);
+
+			// if this is a TT cut, return the proper value
+			if (TTval.cut())
+			{
+				return AlphaBetaValue(TTval.score(), TTval.entry().getBestMove(playerToMove));
+			}
 		}
 	}
 
@@ -406,17 +533,21 @@ AlphaBetaValue AlphaBetaSearch::alphaBeta(GameState & state, size_t depth, const
 	// move generation
 	MoveArray & moves = _allMoves[depth];
 	state.generateMoves(moves, playerToMove);
-    moves.shuffleMoveActions();
+    moves.shuffleMoveActions(_random);
 	generateOrderedMoves(state, moves, TTval, playerToMove, depth);
 
+	const AlphaBetaMove ttMove = getTTMove(moves, TTval, playerToMove, depth);
+
 	// while we have more simultaneous moves
 	AlphaBetaMove bestMove, bestSimResponse;
 	    
     size_t moveNumber(0);
+    size_t nextChild(0);
+    size_t moveIndex(0);
     std::vector<Action> moveVec;
 
     // for each child
-    while (getNextMoveVec(playerToMove, moves, moveNumber, TTval, depth, moveVec))
+    while (getNextMoveVec(playerToMove, moves, moveNumber, nextChild, ttMove, TTval, depth, moveVec, moveIndex))
 	{
         // the value of the recursive AB we will call
 		AlphaBetaValue val;
@@ -448,6 +579,12 @@ AlphaBetaValue AlphaBetaSearch::alphaBeta(GameState & state, size_t depth, const
             child.makeMoves(moveVec);
 			child.finishedMoving();
 
+			// the child will look itself up in the TT, so start fetching its bucket now
+			if (depth > 1)
+			{
+				_TT->prefetch(child.calculateHash(0));
+			}
+
 			// get the alpha beta value
 			val = alphaBeta(child, depth-1, playerToMove, NULL, alpha, beta);
 		}
@@ -456,7 +593,7 @@ AlphaBetaValue AlphaBetaSearch::alphaBeta(GameState & state, size_t depth, const
 		if (maxPlayer && (val.score() > alpha)) 
 		{
 			alpha = val.score();
-			bestMove = AlphaBetaMove(moveVec, true);
+			bestMove = AlphaBetaMove(moveVec, true, moveIndex);
 			bestMoveSet = true;
 
 			if (state.bothCanMove() && !prevSimMove)
@@ -469,7 +606,7 @@ AlphaBetaValue AlphaBetaSearch::alphaBeta(GameState & state, size_t depth, const
 		else if (!maxPlayer && (val.score() < beta))
 		{
 			beta = val.score();
-			bestMove = AlphaBetaMove(moveVec, true);
+			bestMove = AlphaBetaMove(moveVec, true, moveIndex);
 			bestMoveSet = true;
 
 			if (state.bothCanMove() && prevSimMove)
@@ -486,6 +623,14 @@ AlphaBetaValue AlphaBetaSearch::alphaBeta(GameState & state, size_t depth, const
 		// alpha-beta cut
 		if (alpha >= beta) 
 		{ 
+			_results.cutoffs++;
+			_results.firstChildCutoffs += (moveNumber == 0);
+
+			if (useHistory())
+			{
+				_history.addCutoff(state, moveVec, _currentRootDepth - depth, depth);
+			}
+
 			break; 
 		}
 
@@ -506,6 +651,11 @@ AlphaBetaSearchResults & AlphaBetaSearch::getResults()
 	return _results;
 }
 
+AlphaBetaSearchParameters & AlphaBetaSearch::getParams()
+{
+	return _params;
+}
+
 const IDType AlphaBetaSearch::getEnemy(const IDType & player) const
 {
 	return (player + 1) % 2;
@@ -516,19 +666,25 @@ const bool AlphaBetaSearch::isRoot(const size_t & depth) const
 	return depth == _currentRootDepth;
 }
 
+const bool AlphaBetaSearch::useHistory() const
+{
+	return _params.moveOrderingMethod() == MoveOrderMethod::ScriptFirstHistory;
+}
+
 void AlphaBetaSearch::printTTResults() const
 {
 	printf("\n");
+	printf("Size MB                %9d\n", (int)_TT->getSizeMB());
 	printf("Total Usage            %9d\n", (int)_TT->getUsage());
 	printf("Save Attempt           %9d\n", (int)_results.ttSaveAttempts);
-	printf("   Save Succeed        %9d\n", (int)_TT->numSaves());
-	printf("      Save Empty       %9d\n", (int)_TT->saveEmpty);
-	printf("      Save Self        %9d\n", (int)_TT->saveOverwriteSelf);
-	printf("      Save Other       %9d\n", (int)_TT->saveOverwriteOther);
-	printf("Look-Up                %9d\n", (int)_TT->numLookups());
-	printf("   Not Found           %9d\n", (int)_TT->numNotFound());
-	printf("   Collisions          %9d\n", (int)_TT->numCollisions());
-	printf("   Found               %9d\n", (int)_TT->numFound());
+	printf("   Save Succeed        %9d\n", (int)_results.ttStats.saves);
+	printf("      Save Empty       %9d\n", (int)_results.ttStats.saveEmpty);
+	printf("      Save Self        %9d\n", (int)_results.ttStats.saveOverwriteSelf);
+	printf("      Save Other       %9d\n", (int)_results.ttStats.saveOverwriteOther);
+	printf("Look-Up                %9d\n", (int)_results.ttStats.lookups);
+	printf("   Not Found           %9d\n", (int)_results.ttStats.notFound);
+	printf("   Collisions          %9d\n", (int)_results.ttStats.collisions);
+	printf("   Found               %9d\n", (int)_results.ttStats.found);
 	printf("      Less Depth       %9d\n", (int)_results.ttFoundLessDepth);
 	printf("      More Depth       %9d\n", ((int)_results.ttFoundCheck + (int)_results.ttcuts));
 	printf("         Cut           %9d\n", (int)_results.ttcuts);
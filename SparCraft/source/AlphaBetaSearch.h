@@ -1,6 +1,8 @@
 #pragma once
 
 #include <limits>
+#include <atomic>
+#include <thread>
 
 #include "AllPlayers.h"
 #include "Timer.h"
@@ -9,6 +11,7 @@
 #include "Array.hpp"
 #include "MoveArray.h"
 #include "TranspositionTable.h"
+#include "HistoryTable.hpp"
 #include "Player.h"
 
 #include "AlphaBetaSearchResults.hpp"
@@ -42,15 +45,22 @@ class AlphaBetaSearch
     PlayerPtr                               _playerModels[Constants::Num_Players];
 
 	TTPtr                                   _TT;
+	Random                                  _random;
+	HistoryTable                            _history;       // only used with MoveOrderMethod::ScriptFirstHistory
+
+	// set by the main thread to stop Lazy SMP helper threads
+	std::atomic<bool> *                     _stopSearch;
 
 public:
 
 	AlphaBetaSearch(const AlphaBetaSearchParameters & params, TTPtr TT = TTPtr((TranspositionTable *)NULL));
 
 	void doSearch(GameState & initialState);
+	void setSeed(const unsigned long long & seed);
 
 	// search functions
-	AlphaBetaValue IDAlphaBeta(GameState & initialState, const size_t & maxDepth);
+	AlphaBetaValue IDAlphaBeta(GameState & initialState, const size_t & maxDepth, const size_t & startDepth = 1);
+	AlphaBetaValue lazySMPSearch(GameState & initialState, const size_t & maxDepth);
 	AlphaBetaValue alphaBeta(GameState & state, size_t depth, const IDType lastPlayerToMove, std::vector<Action> * firstSimMove, StateEvalScore alpha, StateEvalScore beta);
 
 	// Transposition Table
@@ -62,15 +72,18 @@ public:
 
 	// get the results from the search
 	AlphaBetaSearchResults & getResults();
+	AlphaBetaSearchParameters & getParams();
     	
 	void generateOrderedMoves(GameState & state, MoveArray & moves, const TTLookupValue & TTval, const IDType & playerToMove, const size_t & depth);
 	const IDType getEnemy(const IDType & player) const;
-	const IDType getPlayerToMove(GameState & state, const size_t & depth, const IDType & lastPlayerToMove, const bool isFirstSimMove) const;
-	bool getNextMoveVec(IDType playerToMove, MoveArray & moves, const size_t & moveNumber, const TTLookupValue & TTval, const size_t & depth, std::vector<Action> & moveVec) const;
+	const IDType getPlayerToMove(GameState & state, const size_t & depth, const IDType & lastPlayerToMove, const bool isFirstSimMove);
+	AlphaBetaMove getTTMove(MoveArray & moves, const TTLookupValue & TTval, const IDType & playerToMove, const size_t & depth);
+	bool getNextMoveVec(IDType playerToMove, MoveArray & moves, const size_t & moveNumber, size_t & nextChild, const AlphaBetaMove & ttMove, 
+						const TTLookupValue & TTval, const size_t & depth, std::vector<Action> & moveVec, size_t & moveIndex) const;
 	const size_t getNumMoves(MoveArray & moves, const TTLookupValue & TTval, const IDType & playerToMove, const size_t & depth) const;
-	const AlphaBetaMove & getAlphaBetaMove(const TTLookupValue & TTval, const IDType & playerToMove) const;
 	const bool searchTimeOut();
 	const bool isRoot(const size_t & depth) const;
+	const bool useHistory() const;
 	const bool terminalState(GameState & state, const size_t & depth) const;
 	const bool isTranspositionLookupState(GameState & state, const std::vector<Action> * firstSimMove) const;
 
@@ -20,6 +20,8 @@ class SparCraft::AlphaBetaSearchParameters
     IDType          _simScripts[2];                 // NOKDPS               Policy to use for playouts
 	IDType		    _playerToMoveMethod;		    // Alternate			The player to move policy
 	IDType		    _playerModel[2];                // None                 Player model to use for each player
+    size_t          _numThreads;                    // 1                    Number of Lazy SMP threads for ID-AB
+    size_t          _ttSizeMB;                      // TT_Size_MB           Size of the transposition table the search creates
 
     std::string     _graphVizFilename;              // ""                   File name to output graph viz file
 
@@ -39,6 +41,8 @@ public:
         , _moveOrdering         (MoveOrderMethod::ScriptFirst)
         , _evalMethod           (SparCraft::EvaluationMethods::Playout)
 	    , _playerToMoveMethod   (SparCraft::PlayerToMove::Alternate)
+        , _numThreads           (1)
+        , _ttSizeMB             (Constants::Transposition_Table_Size_MB)
     {
 	    setPlayerModel(Players::Player_One, PlayerModels::None);
 	    setPlayerModel(Players::Player_Two, PlayerModels::None);
@@ -56,6 +60,8 @@ public:
     const IDType & playerToMoveMethod()				            const   { return _playerToMoveMethod; }
     const IDType & playerModel(const IDType & player)	        const   { return _playerModel[player]; }
     const std::string & graphVizFilename()                      const   { return _graphVizFilename; }
+    const size_t & numThreads()                                 const   { return _numThreads; }
+    const size_t & ttSizeMB()                                   const   { return _ttSizeMB; }
     const std::vector<IDType> & getOrderedMoveScripts()         const   { return _orderedMoveScripts; }
 	
     void setSearchMethod(const IDType & method)                         { _searchMethod = method; }
@@ -71,6 +77,8 @@ public:
     void setGraphVizFilename(const std::string & filename)              { _graphVizFilename = filename; }
     void addOrderedMoveScript(const IDType & script)                    { _orderedMoveScripts.push_back(script); }
     void setPlayerModel(const IDType & player, const IDType & model)	{ _playerModel[player] = model; }	
+    void setNumThreads(const size_t & threads)                          { _numThreads = threads; }
+    void setTTSizeMB(const size_t & sizeMB)                             { _ttSizeMB = sizeMB; }
 
     std::vector<std::vector<std::string> > & getDescription()
     {
@@ -87,6 +95,8 @@ public:
             _desc[0].push_back("Move Ordering:");
             _desc[0].push_back("Player To Move:");
             _desc[0].push_back("Opponent Model:");
+            _desc[0].push_back("Threads:");
+            _desc[0].push_back("TT Size:");
 
             ss << "AlphaBeta";                                              _desc[1].push_back(ss.str()); ss.str(std::string());
             ss << timeLimit() << "ms";                                      _desc[1].push_back(ss.str()); ss.str(std::string());
@@ -94,6 +104,8 @@ public:
             ss << MoveOrderMethod::getName(moveOrderingMethod());             _desc[1].push_back(ss.str()); ss.str(std::string());
             ss << PlayerToMove::getName(playerToMoveMethod());                _desc[1].push_back(ss.str()); ss.str(std::string());
             ss << PlayerModels::getName(playerModel((maxPlayer()+1)%2));   _desc[1].push_back(ss.str()); ss.str(std::string());
+            ss << numThreads();                                             _desc[1].push_back(ss.str()); ss.str(std::string());
+            ss << ttSizeMB() << "MB";                                       _desc[1].push_back(ss.str()); ss.str(std::string());
         }
         
         return _desc;
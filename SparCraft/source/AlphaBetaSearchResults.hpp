@@ -2,6 +2,7 @@
 
 #include <vector>
 #include "Action.h"
+#include "TranspositionTable.h"
 
 namespace SparCraft
 {
@@ -14,6 +15,7 @@ public:
 						timedOut;		// did the search time-out?
 	
 	unsigned long long 	nodesExpanded;	// number of nodes expanded in the search
+	unsigned long long 	totalNodesExpanded;	// nodes expanded by all Lazy SMP threads, including this one
 	
 	double 				timeElapsed,	// time elapsed in milliseconds
 						avgBranch;		// avg branching factor
@@ -21,6 +23,8 @@ public:
     std::vector<Action>   bestMoves;
 	ScoreType			abValue;
 	unsigned long long  ttcuts;
+	unsigned long long  cutoffs;			// nodes searched by this thread that ended in an alpha-beta cut
+	unsigned long long  firstChildCutoffs;	// of those, how many were cut by their first child
 	size_t				maxDepthReached;	
 
 	size_t				ttMoveOrders;
@@ -29,6 +33,7 @@ public:
 	size_t				ttFoundCheck;
 	size_t				ttFoundLessDepth;
 	size_t				ttSaveAttempts;
+	TTStats				ttStats;		// transposition table activity of the last search
 
     std::vector<std::vector<std::string> > _desc;    // 2-column description vector
 	
@@ -36,10 +41,13 @@ public:
 		: solved(false)
 		, timedOut(false)
 		, nodesExpanded(0)
+		, totalNodesExpanded(0)
 		, timeElapsed(0)
 		, avgBranch(0)
 		, abValue(0)
 		, ttcuts(0)
+		, cutoffs(0)
+		, firstChildCutoffs(0)
 		, maxDepthReached(0)
 		, ttMoveOrders(0)
 		, ttFoundButNoMove(0)
@@ -50,6 +58,12 @@ public:
 	{
 	}
 
+    // how often the first child tried was good enough to cut, a measure of move ordering quality
+    double firstChildCutoffRate() const
+    {
+        return cutoffs ? ((double)firstChildCutoffs / cutoffs) : 0;
+    }
+
     std::vector<std::vector<std::string> > & getDescription()
     {
         _desc.clear();
@@ -61,10 +75,12 @@ public:
         _desc[0].push_back("Nodes Searched: ");
         _desc[0].push_back("AB Value: ");
         _desc[0].push_back("Max Depth: ");
+        _desc[0].push_back("First Child Cuts: ");
 
         ss << nodesExpanded;       _desc[1].push_back(ss.str()); ss.str(std::string());
         ss << abValue;              _desc[1].push_back(ss.str()); ss.str(std::string());
         ss << maxDepthReached;     _desc[1].push_back(ss.str()); ss.str(std::string());
+        ss << (int)(100 * firstChildCutoffRate()) << "%";  _desc[1].push_back(ss.str()); ss.str(std::string());
         
         return _desc;
     }
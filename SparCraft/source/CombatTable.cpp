@@ -0,0 +1,125 @@
+#include "CombatTable.h"
+#include "PlayerProperties.h"
+#include "UnitProperties.h"
+#include "WeaponProperties.h"
+
+using namespace SparCraft;
+
+HealthType			CombatTable::damage[NUM_TYPES];
+TimeType			CombatTable::attackCooldown[NUM_TYPES];
+float				CombatTable::dpf[NUM_TYPES];
+BWAPI::UpgradeType	CombatTable::rangeUpgrade[NUM_TYPES];
+PositionType		CombatTable::range[NUM_TYPES][NUM_RANGE_LEVELS];
+BWAPI::UpgradeType	CombatTable::weaponUpgrade[NUM_TYPES][NUM_WEAPONS];
+int					CombatTable::weaponDamage[NUM_TYPES][NUM_WEAPONS][NUM_WEAPON_LEVELS];
+float				CombatTable::damageMultiplier[NUM_TYPES][NUM_WEAPONS][NUM_SIZES];
+int					CombatTable::hitsPerAttack[NUM_TYPES];
+BWAPI::UpgradeType	CombatTable::armorUpgrade[NUM_TYPES];
+BWAPI::UpgradeType	CombatTable::extraArmorUpgrade[NUM_TYPES];
+int					CombatTable::armor[NUM_TYPES][NUM_ARMOR_LEVELS][NUM_EXTRA_ARMOR_LEVELS];
+int					CombatTable::weaponAgainst[NUM_TYPES];
+int					CombatTable::size[NUM_TYPES];
+
+namespace
+{
+	// a player's level of an upgrade, limited to the levels a table holds
+	int level(const PlayerProperties & player, BWAPI::UpgradeType upgrade, const int numLevels)
+	{
+		return std::min(player.GetUpgradeLevel(upgrade), numLevels - 1);
+	}
+
+	// sets an upgrade to a table level on properties used to build the tables
+	void setLevel(PlayerProperties & player, BWAPI::UpgradeType upgrade, const int level)
+	{
+		if (upgrade != BWAPI::UpgradeTypes::None && upgrade != BWAPI::UpgradeTypes::Unknown)
+		{
+			player.SetUpgradeLevel(upgrade, std::min(level, upgrade.maxRepeats()));
+		}
+	}
+}
+
+// builds the tables, must be called after WeaponProperties and UnitProperties are initialized
+void CombatTable::Init()
+{
+	for (const BWAPI::UnitType & type : BWAPI::UnitTypes::allUnitTypes())
+	{
+		if (!System::isSupportedUnitType(type))
+		{
+			continue;
+		}
+
+		const int id(type.getID());
+
+		// zealots hit twice per attack
+		damage[id]			= (HealthType)type.groundWeapon().damageAmount() * (type == BWAPI::UnitTypes::Protoss_Zealot ? 2 : 1);
+		attackCooldown[id]	= (TimeType)type.groundWeapon().damageCooldown();
+		dpf[id]				= (float)std::max(Constants::Min_Unit_DPF, (float)damage[id] / ((float)attackCooldown[id] + 1));
+
+		rangeUpgrade[id] = WeaponProperties::Get(type.groundWeapon()).GetRangeUpgrade();
+		for (int l(0); l < NUM_RANGE_LEVELS; ++l)
+		{
+			PlayerProperties player;
+			setLevel(player, rangeUpgrade[id], l);
+			range[id][l] = WeaponProperties::Get(type.groundWeapon()).GetMaxRange(player) + Constants::Range_Addition;
+		}
+
+		// special case where units attack multiple times
+		hitsPerAttack[id] = (type == BWAPI::UnitTypes::Protoss_Zealot || type == BWAPI::UnitTypes::Terran_Firebat) ? 2 : 1;
+
+		for (int w(0); w < NUM_WEAPONS; ++w)
+		{
+			const BWAPI::WeaponType weapon(w == AIR ? type.airWeapon() : type.groundWeapon());
+
+			weaponUpgrade[id][w] = weapon.upgradeType();
+			for (int l(0); l < NUM_WEAPON_LEVELS; ++l)
+			{
+				PlayerProperties player;
+				setLevel(player, weaponUpgrade[id][w], l);
+				weaponDamage[id][w][l] = WeaponProperties::Get(weapon).GetDamageBase(player);
+			}
+
+			for (int s(0); s < NUM_SIZES; ++s)
+			{
+				damageMultiplier[id][w][s] = damageMultipliers[weapon.damageType().getID()][s];
+			}
+		}
+
+		armorUpgrade[id]		= type.armorUpgrade();
+		extraArmorUpgrade[id]	= UnitProperties::Get(type).GetExtraArmorUpgrade();
+		for (int a(0); a < NUM_ARMOR_LEVELS; ++a)
+		{
+			for (int x(0); x < NUM_EXTRA_ARMOR_LEVELS; ++x)
+			{
+				PlayerProperties player;
+				setLevel(player, armorUpgrade[id], a);
+				setLevel(player, extraArmorUpgrade[id], x);
+				armor[id][a][x] = UnitProperties::Get(type).GetArmor(player);
+			}
+		}
+
+		weaponAgainst[id]	= type.isFlyer() ? AIR : GROUND;
+		size[id]			= type.size().getID();
+	}
+}
+
+PositionType CombatTable::GetRange(const IDType & player, BWAPI::UnitType type)
+{
+	const int id(type.getID());
+
+	return range[id][level(PlayerProperties::Get(player), rangeUpgrade[id], NUM_RANGE_LEVELS)];
+}
+
+HealthType CombatTable::GetDamageTo(const IDType & player, BWAPI::UnitType type, BWAPI::UnitType target)
+{
+	const PlayerProperties & attacker(PlayerProperties::Get(player));
+	const PlayerProperties & defender(PlayerProperties::Get(1 - player));
+	const int id(type.getID());
+	const int targetID(target.getID());
+	const int weapon(weaponAgainst[targetID]);
+
+	const int hit(weaponDamage[id][weapon][level(attacker, weaponUpgrade[id][weapon], NUM_WEAPON_LEVELS)]);
+	const int targetArmor(armor[targetID][level(defender, armorUpgrade[targetID], NUM_ARMOR_LEVELS)][level(defender, extraArmorUpgrade[targetID], NUM_EXTRA_ARMOR_LEVELS)]);
+
+	// calculate the damage based on armor and damage types
+	return (HealthType)(std::max((int)((hit - targetArmor) * damageMultiplier[id][weapon][size[targetID]]), 2) * hitsPerAttack[id]);
+}
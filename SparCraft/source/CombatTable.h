@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Common.h"
+
+namespace SparCraft
+{
+
+// combat values of every supported unit type, indexed by BWAPI unit type ID
+// values which depend on upgrades are stored for every upgrade level, and the player's current
+// levels are only looked up when a value is read. the tables are built once by SparCraft::init
+// and never change afterwards, so any number of threads can read them while upgrades are set
+class CombatTable
+{
+	enum						{ NUM_TYPES = 256, NUM_SIZES = 6, NUM_WEAPON_LEVELS = 4, NUM_ARMOR_LEVELS = 4, NUM_EXTRA_ARMOR_LEVELS = 2, NUM_RANGE_LEVELS = 2 };
+	enum						{ GROUND, AIR, NUM_WEAPONS };
+
+	static HealthType			damage[NUM_TYPES];
+	static TimeType				attackCooldown[NUM_TYPES];
+	static float				dpf[NUM_TYPES];
+
+	// ground weapon range for each level of its range upgrade
+	static BWAPI::UpgradeType	rangeUpgrade[NUM_TYPES];
+	static PositionType			range[NUM_TYPES][NUM_RANGE_LEVELS];
+
+	// damage of one hit of each weapon before armor for each level of its damage upgrade, and its multiplier against each unit size
+	static BWAPI::UpgradeType	weaponUpgrade[NUM_TYPES][NUM_WEAPONS];
+	static int					weaponDamage[NUM_TYPES][NUM_WEAPONS][NUM_WEAPON_LEVELS];
+	static float				damageMultiplier[NUM_TYPES][NUM_WEAPONS][NUM_SIZES];
+	static int					hitsPerAttack[NUM_TYPES];
+
+	// armor of a unit type for each level of its armor upgrade and of its extra armor upgrade
+	static BWAPI::UpgradeType	armorUpgrade[NUM_TYPES];
+	static BWAPI::UpgradeType	extraArmorUpgrade[NUM_TYPES];
+	static int					armor[NUM_TYPES][NUM_ARMOR_LEVELS][NUM_EXTRA_ARMOR_LEVELS];
+	static int					weaponAgainst[NUM_TYPES];
+	static int					size[NUM_TYPES];
+
+public:
+
+	static HealthType			GetDamage(BWAPI::UnitType type)											{ return damage[type.getID()]; }
+	static TimeType				GetAttackCooldown(BWAPI::UnitType type)									{ return attackCooldown[type.getID()]; }
+	static float				GetDPF(BWAPI::UnitType type)											{ return dpf[type.getID()]; }
+	static PositionType			GetRange(const IDType & player, BWAPI::UnitType type);
+
+	// damage done by one attack of the player's unit type to a unit of the target type owned by the enemy
+	static HealthType			GetDamageTo(const IDType & player, BWAPI::UnitType type, BWAPI::UnitType target);
+
+	static void					Init();
+};
+}
@@ -55,8 +55,7 @@ namespace SparCraft
 
 		// whether to use transposition table in search
 		const bool   Use_Transposition_Table	= true;
-		const size_t Transposition_Table_Size	= 100000;
-		const size_t Transposition_Table_Scan	= 10;
+		const size_t Transposition_Table_Size_MB	= 16;
 		const size_t Num_Hashes					= 2;
         
         // UCT options
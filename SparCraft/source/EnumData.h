@@ -159,13 +159,14 @@ public:
 class MoveOrderMethod : public EnumData<MoveOrderMethod>
 {
 public:
-    enum { ScriptFirst, None, Size };
+    enum { ScriptFirst, None, ScriptFirstHistory, Size };
     static void init()
     {
         setType("MoveOrderMethod");
         names.resize(Size);
-        setData(ScriptFirst,    "ScriptFirst");
-        setData(None,           "None");
+        setData(ScriptFirst,        "ScriptFirst");
+        setData(None,               "None");
+        setData(ScriptFirstHistory, "ScriptFirstHistory");
     }
 };
 
@@ -183,6 +184,19 @@ public:
     }
 };
 
+class UCTParallelMethods : public EnumData<UCTParallelMethods>
+{
+public:
+    enum { Root, Tree, Size };
+    static void init()
+    {
+        setType("UCTParallelMethods");
+        names.resize(Size);
+        setData(Root,           "Root");
+        setData(Tree,           "Tree");
+    }
+};
+
 extern void EnumDataInit();
 
 }
\ No newline at end of file
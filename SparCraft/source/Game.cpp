@@ -24,6 +24,24 @@ Game::Game(const GameState & initialState, PlayerPtr & p1, PlayerPtr & p2, const
     _players[Players::Player_Two] = p2;
 }
 
+void Game::reset(const GameState & initialState)
+{
+    state = initialState;
+    rounds = 0;
+    gameTimeMS = 0;
+}
+
+void Game::setSeed(const unsigned long long & seed)
+{
+    for (IDType p(0); p < Constants::Num_Players; ++p)
+    {
+        if (_players[p])
+        {
+            _players[p]->setSeed(Random::Get(seed, p));
+        }
+    }
+}
+
 // play the game until there is a winner
 void Game::play()
 {
@@ -82,13 +100,12 @@ void Game::playNextTurn()
 }
 
 // play the game until there is a winner
+// plays the game out with each unit following its own script
+// the move buffers here and in scriptData keep their capacity, so replaying from a reset() Game doesn't allocate
 void Game::playIndividualScripts(UnitScriptData & scriptData)
 {
-    // array which will hold all the script moves for players
-    Array2D<std::vector<Action>, Constants::Num_Players, PlayerModels::Size> allScriptMoves;
-
-    scriptMoves[Players::Player_One] = std::vector<Action>(state.numUnits(Players::Player_One));
-    scriptMoves[Players::Player_Two] = std::vector<Action>(state.numUnits(Players::Player_Two));
+    scriptMoves[Players::Player_One].reserve(Constants::Max_Units);
+    scriptMoves[Players::Player_Two].reserve(Constants::Max_Units);
 
     t.start();
 
@@ -100,18 +117,6 @@ void Game::playIndividualScripts(UnitScriptData & scriptData)
             break;
         }
 
-        Timer frameTimer;
-        frameTimer.start();
-
-        // clear all script moves for both players
-        for (IDType p(0); p<Constants::Num_Players; p++)
-        {
-            for (IDType s(0); s<PlayerModels::Size; ++s)
-            {
-                allScriptMoves[p][s].clear();
-            }
-        }
-
         // clear the moves we will actually be doing
         scriptMoves[0].clear();
         scriptMoves[1].clear();
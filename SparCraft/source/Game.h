@@ -41,6 +41,12 @@ public:
 	Game(const GameState & initialState, PlayerPtr & p1, PlayerPtr & p2, const size_t & limit);
     Game(const GameState & initialState, const size_t & limit);
 
+    // starts this game over from a new state, keeping the players and move buffers
+    void            reset(const GameState & initialState);
+
+    // gives each player its own random sequence derived from the game's seed, so the game replays identically
+    void            setSeed(const unsigned long long & seed);
+
 	void            play();
     void            playNextTurn();
     void            playIndividualScripts(UnitScriptData & scriptsChosen);
@@ -1,4 +1,5 @@
 #include "GameState.h"
+#include "GameStateFile.h"
 #include "Player.h"
 #include "Game.h"
 
@@ -37,11 +38,10 @@ GameState::GameState()
 	_prevNumUnits.fill(0);
 	_numMovements.fill(0);
     _prevHPSum.fill(0);
-
-    _units[0] = std::vector<Unit>(Constants::Max_Units, Unit());
-    _units[1] = std::vector<Unit>(Constants::Max_Units, Unit());
-    _unitIndex[0] = std::vector<int>(Constants::Max_Units, 0);
-    _unitIndex[1] = std::vector<int>(Constants::Max_Units, 0);
+    _ltdSum.fill(0);
+    _ltd2Sum.fill(0);
+    _numAttackers.fill(0);
+    _playerHash.fill(0);
 
 	for (size_t u(0); u<_maxUnits; ++u)
 	{
@@ -52,6 +52,7 @@ GameState::GameState()
 
 // construct state from a save file
 GameState::GameState(const std::string & filename)
+    : _map(NULL)
 {
     read(filename);
 }
@@ -91,21 +92,89 @@ void GameState::finishedMoving()
 	{
         _prevHPSum[p] = hpSum[p];
     }
+
+    updateUnitGrid();
+}
+
+// buckets every unit by where it is at the current time
+void GameState::updateUnitGrid()
+{
+    // scanning every unit is cheaper than building the grid in small battles
+    if (numUnits(Players::Player_One) + numUnits(Players::Player_Two) < UnitGrid::Min_Units)
+    {
+        _unitGrid.invalidate();
+        return;
+    }
+
+    Array2D<Position, Constants::Num_Players, Constants::Max_Units> positions;
+
+    for (IDType p(0); p<Constants::Num_Players; ++p)
+	{
+		for (IDType u(0); u<numUnits(p); ++u)
+		{ 
+            positions[p][u] = getUnit(p, u).currentPosition(_currentTime);
+        }
+    }
+
+    _unitGrid.build(positions, _numUnits);
 }
 
+// whether one of the player's detectors can see the given unit
+const bool GameState::isDetected(const IDType & player, const Unit & unit) const
+{
+	for (IDType detectorIndex(0); detectorIndex < _numUnits[player]; ++detectorIndex)
+	{
+		// unit reference
+		const Unit & detector(getUnit(player, detectorIndex));
+		if (detector.type().isDetector() && detector.canSeeTarget(unit, _currentTime))
+		{
+			return true;
+		}
+	}
+
+    return false;
+}
+
+// returns the hash of the state, which is kept up to date as units change
 const HashType GameState::calculateHash(const size_t & hashNum) const
 {
-	HashType hash(0);
+    const unsigned long long unitsHash(_playerHash[Players::Player_One] ^ _playerHash[Players::Player_Two]);
+    const HashType hash = (HashType)(unitsHash >> (32 * hashNum)) ^ Hash::values[hashNum].getTimeHash(_currentTime);
+
+#ifdef SPARCRAFT_DEBUG_HASH
+    SPARCRAFT_ASSERT(hash == calculateFullHash(hashNum), "Incremental hash %u does not match full hash %u", hash, calculateFullHash(hashNum));
+#endif
+
+	return hash;
+}
+
+// recalculates the hash of the state from scratch
+const HashType GameState::calculateFullHash(const size_t & hashNum) const
+{
+	unsigned long long unitsHash(0);
 
 	for (IDType p(0); p < Constants::Num_Players; ++p)
 	{
-		for (IDType u(0); u < _numUnits[p]; ++u)
+		for (size_t slot(0); slot < Constants::Max_Units; ++slot)
 		{
-			hash ^= Hash::magicHash(getUnit(p,u).calculateHash(hashNum, _currentTime), p, u);
+			if (_units[p][slot].isAlive())
+			{
+				unitsHash ^= _units[p][slot].calculateHash();
+			}
 		}
 	}
 
-	return hash;
+	return (HashType)(unitsHash >> (32 * hashNum)) ^ Hash::values[hashNum].getTimeHash(_currentTime);
+}
+
+// xors the hash of a unit into or out of its player's hash, dead units hash to nothing
+// call it once before a unit changes and once after
+void GameState::xorUnitHash(const Unit & unit)
+{
+    if (unit.isAlive())
+    {
+        _playerHash[unit.player()] ^= unit.calculateHash();
+    }
 }
 
 void GameState::generateMoves(MoveArray & moves, const IDType & playerIndex) const
@@ -148,30 +217,38 @@ void GameState::generateMoves(MoveArray & moves, const IDType & playerIndex) con
 		// generate attack moves
 		if (unit.canAttackNow())
 		{
-			for (IDType u(0); u<_numUnits[enemyPlayer]; ++u)
-			{
+            auto addAttack = [&](const IDType & u)
+            {
 				const Unit & enemyUnit(getUnit(enemyPlayer, u));
-				bool invisible = false;
-				if (enemyUnit.type().hasPermanentCloak())
-				{
-					invisible = true;
-					for (IDType detectorIndex(0); detectorIndex < _numUnits[playerIndex]; ++detectorIndex)
-					{
-						// unit reference
-						const Unit & detector(getUnit(playerIndex, detectorIndex));
-						if (detector.type().isDetector() && detector.canSeeTarget(enemyUnit, _currentTime))
-						{
-							invisible = false;
-							break;
-						}
-					}
-				}
+				bool invisible = enemyUnit.type().hasPermanentCloak() && !isDetected(playerIndex, enemyUnit);
+
 				if (!invisible && unit.canAttackTarget(enemyUnit, _currentTime) && enemyUnit.isAlive())
 				{
 					moves.add(Action(unitIndex, playerIndex, ActionTypes::ATTACK, u));
                     //moves.add(Action(unitIndex, playerIndex, ActionTypes::ATTACK, unit.ID()));
 				}
-			}
+            };
+
+            if (_unitGrid.isValid())
+            {
+                // only enemies in the cells within range can be targets, they are added in index order as the full scan does
+                Array<IDType, Constants::Max_Units> targets;
+                auto addTarget = [&](const IDType & u) { targets.add(u); };
+                _unitGrid.forEachInRadius(enemyPlayer, unit.currentPosition(_currentTime), unit.range(), addTarget);
+
+                std::sort(&targets[0], &targets[0] + targets.size());
+                for (size_t t(0); t < targets.size(); ++t)
+                {
+                    addAttack(targets[t]);
+                }
+            }
+            else
+            {
+			    for (IDType u(0); u<_numUnits[enemyPlayer]; ++u)
+			    {
+                    addAttack(u);
+			    }
+            }
 		}
 		else if (unit.canHealNow())
 		{
@@ -260,6 +337,15 @@ void GameState::generateMoves(MoveArray & moves, const IDType & playerIndex) con
 void GameState::makeMoves(const std::vector<Action> & moves)
 {    
     if (moves.size() > 0)
+    {
+        makeMoves(&moves[0], moves.size());
+    }
+}
+
+// makes a move stored as a contiguous array of actions, such as a move in a UCTMemoryPool
+void GameState::makeMoves(const Action * moves, const size_t & numMoves)
+{    
+    if (numMoves > 0)
     {
         const IDType canMove(whoCanMove());
         const IDType playerToMove(moves[0].player());
@@ -269,7 +355,7 @@ void GameState::makeMoves(const std::vector<Action> & moves)
         }
     }
     
-    for (size_t m(0); m<moves.size(); ++m)
+    for (size_t m(0); m<numMoves; ++m)
     {
         performAction(moves[m]);
     }
@@ -277,10 +363,15 @@ void GameState::makeMoves(const std::vector<Action> & moves)
 
 void GameState::performAction(const Action & move)
 {
+    // actions can change where a unit is at the current time
+    _unitGrid.invalidate();
+
 	Unit & ourUnit		= getUnit(move.player(), move.unit());
 	IDType player		= ourUnit.player();
 	IDType enemyPlayer  = getEnemy(player);
 
+	xorUnitHash(ourUnit);
+
 	if (move.type() == ActionTypes::ATTACK)
 	{
 		Unit & enemyUnit(getUnit(enemyPlayer,move.index()));
@@ -292,7 +383,12 @@ void GameState::performAction(const Action & move)
 		// enemy unit takes damage if it is alive
 		if (enemyUnit.isAlive())
 		{				
+			xorUnitHash(enemyUnit);
+
+			const HealthType oldHP(enemyUnit.currentHP());
 			enemyUnit.takeAttack(ourUnit);
+			updateUnitSums(enemyUnit, oldHP);
+			xorUnitHash(enemyUnit);
 
 			// check to see if enemy unit died
 			if (!enemyUnit.isAlive())
@@ -317,7 +413,12 @@ void GameState::performAction(const Action & move)
 			
 		if (ourOtherUnit.isAlive())
 		{
+			xorUnitHash(ourOtherUnit);
+
+			const HealthType oldHP(ourOtherUnit.currentHP());
 			ourOtherUnit.takeHeal(ourUnit);
+			updateUnitSums(ourOtherUnit, oldHP);
+			xorUnitHash(ourOtherUnit);
 		}
 	}
 	else if (move.type() == ActionTypes::RELOAD)
@@ -328,6 +429,8 @@ void GameState::performAction(const Action & move)
 	{
 		ourUnit.pass(move, _currentTime);
 	}
+
+	xorUnitHash(ourUnit);
 }
 
 const Unit & GameState::getUnitByID(const IDType & unitID) const
@@ -404,34 +507,66 @@ const IDType GameState::getEnemy(const IDType & player) const
 
 const Unit & GameState::getClosestOurUnit(const IDType & player, const IDType & unitIndex)
 {
-	const Unit & myUnit(getUnit(player,unitIndex));
+	return getUnit(player, getClosestOurUnitIndex(player, unitIndex));
+}
 
+// the closest of our units which can't heal, ties go to the lowest index
+const IDType GameState::getClosestOurUnitIndex(const IDType & player, const IDType & unitIndex) const
+{
 	size_t minDist(1000000);
 	IDType minUnitInd(0);
 
-	Position currentPos = myUnit.currentPosition(_currentTime);
+	Position currentPos = getUnit(player,unitIndex).currentPosition(_currentTime);
 
-	for (IDType u(0); u<_numUnits[player]; ++u)
-	{
+    auto closest = [&](const IDType & u)
+    {
 		if (u == unitIndex || getUnit(player, u).canHeal())
 		{
-			continue;
+			return;
 		}
 
-		//size_t distSq(myUnit.distSq(getUnit(enemyPlayer,u)));
 		size_t distSq(currentPos.getDistanceSq(getUnit(player, u).currentPosition(_currentTime)));
 
-		if (distSq < minDist)
+		if ((distSq < minDist) || ((distSq == minDist) && (u < minUnitInd)))
 		{
 			minDist = distSq;
 			minUnitInd = u;
 		}
-	}
+    };
 
-	return getUnit(player, minUnitInd);
+    if (!_unitGrid.isValid())
+    {
+	    for (IDType u(0); u<_numUnits[player]; ++u)
+	    {
+            closest(u);
+	    }
+
+        return minUnitInd;
+    }
+
+    // search outwards one ring of cells at a time until no unit outside the rings searched could be closer
+    const int cx(_unitGrid.getCellX(currentPos.x()));
+    const int cy(_unitGrid.getCellY(currentPos.y()));
+    for (int ring(0); ; ++ring)
+    {
+        _unitGrid.forEachInRing(player, cx, cy, ring, closest);
+
+        if (_unitGrid.ringCoversGrid(cx, cy, ring) || ((size_t)_unitGrid.ringOutsideDistanceSq(currentPos, cx, cy, ring) > minDist))
+        {
+            break;
+        }
+    }
+
+	return minUnitInd;
 }
 
 const Unit & GameState::getClosestEnemyUnit(const IDType & player, const IDType & unitIndex, bool checkCloaked)
+{
+	return getUnit(getEnemy(player), getClosestEnemyUnitIndex(player, unitIndex, checkCloaked));
+}
+
+// the closest enemy unit, ties go to the lowest unit ID
+const IDType GameState::getClosestEnemyUnitIndex(const IDType & player, const IDType & unitIndex, bool checkCloaked) const
 {
 	const IDType enemyPlayer(getEnemy(player));
 	const Unit & myUnit(getUnit(player,unitIndex));
@@ -442,44 +577,48 @@ const Unit & GameState::getClosestEnemyUnit(const IDType & player, const IDType
 
 	Position currentPos = myUnit.currentPosition(_currentTime);
 
-	for (IDType u(0); u<_numUnits[enemyPlayer]; ++u)
-	{
-        Unit & enemyUnit(getUnit(enemyPlayer, u));
-		if (checkCloaked&& enemyUnit.type().hasPermanentCloak())
+    auto closest = [&](const IDType & u)
+    {
+        const Unit & enemyUnit(getUnit(enemyPlayer, u));
+		if (checkCloaked && enemyUnit.type().hasPermanentCloak() && !isDetected(player, enemyUnit))
 		{
-			bool invisible = true;
-			for (IDType detectorIndex(0); detectorIndex < _numUnits[player]; ++detectorIndex)
-			{
-				// unit reference
-				const Unit & detector(getUnit(player, detectorIndex));
-				if (detector.type().isDetector() && detector.canSeeTarget(enemyUnit, _currentTime))
-				{
-					invisible = false;
-					break;
-				}
-			}
-			if (invisible)
-			{
-				continue;
-			}
+			return;
 		}
+
         PositionType distSq = myUnit.getDistanceSqToUnit(enemyUnit, _currentTime);
 
-		if ((distSq < minDist))// || ((distSq == minDist) && (enemyUnit.ID() < minUnitID)))
+		if ((distSq < minDist) || ((distSq == minDist) && (enemyUnit.ID() < minUnitID)))
 		{
 			minDist = distSq;
 			minUnitInd = u;
             minUnitID = enemyUnit.ID();
 		}
-        else if ((distSq == minDist) && (enemyUnit.ID() < minUnitID))
+    };
+
+    if (!_unitGrid.isValid())
+    {
+	    for (IDType u(0); u<_numUnits[enemyPlayer]; ++u)
+	    {
+            closest(u);
+	    }
+
+        return minUnitInd;
+    }
+
+    // search outwards one ring of cells at a time until no unit outside the rings searched could be closer
+    const int cx(_unitGrid.getCellX(currentPos.x()));
+    const int cy(_unitGrid.getCellY(currentPos.y()));
+    for (int ring(0); ; ++ring)
+    {
+        _unitGrid.forEachInRing(enemyPlayer, cx, cy, ring, closest);
+
+        if (_unitGrid.ringCoversGrid(cx, cy, ring) || (_unitGrid.ringOutsideDistanceSq(currentPos, cx, cy, ring) > minDist))
         {
-            minDist = distSq;
-			minUnitInd = u;
-            minUnitID = enemyUnit.ID();
+            break;
         }
-	}
+    }
 
-	return getUnit(enemyPlayer, minUnitInd);
+	return minUnitInd;
 }
 
 const bool GameState::checkFull(const IDType & player) const
@@ -509,6 +648,7 @@ void GameState::addUnit(const Unit & u)
     // Set the unit and it's unitID
 	getUnit(u.player(), _numUnits[u.player()]) = u;
     getUnit(u.player(), _numUnits[u.player()]).setUnitID(unitID);
+    xorUnitHash(getUnit(u.player(), _numUnits[u.player()]));
 
     // Increment the number of units this player has
 	_numUnits[u.player()]++;
@@ -538,6 +678,7 @@ void GameState::addUnit(const BWAPI::UnitType type, const IDType playerID, const
     // Set the unit and it's unitID
 	getUnit(playerID, _numUnits[playerID]) = Unit(type, playerID, pos);
     getUnit(playerID, _numUnits[playerID]).setUnitID(unitID);
+    xorUnitHash(getUnit(playerID, _numUnits[playerID]));
 
     // Increment the number of units this player has
 	_numUnits[playerID]++;
@@ -562,6 +703,7 @@ void GameState::addUnitWithID(const Unit & u)
 
     // Simply add the unit to the array
 	getUnit(u.player(), _numUnits[u.player()]) = u;
+    xorUnitHash(getUnit(u.player(), _numUnits[u.player()]));
 
     // Increment the number of units this player has
 	_numUnits[u.player()]++;
@@ -650,20 +792,11 @@ const size_t GameState::closestEnemyUnitDistance(const Unit & unit) const
 
 const bool GameState::playerDead(const IDType & player) const
 {
-	if (numUnits(player) <= 0)
-	{
-		return true;
-	}
+#ifdef SPARCRAFT_DEBUG_EVAL
+    checkUnitSums(player);
+#endif
 
-	for (size_t u(0); u<numUnits(player); ++u)
-	{
-		if (getUnit(player, u).damage() > 0)
-		{
-			return false;
-		}
-	}
-
-	return true;
+	return (numUnits(player) <= 0) || (_numAttackers[player] == 0);
 }
 
 const IDType GameState::whoCanMove() const
@@ -820,46 +953,102 @@ void GameState::calculateStartingHealth()
 		_totalLTD[p] = totalHP;
 		_totalSumSQRT[p] = totalSQRT;
 	}
+
+    calculateUnitSums();
 }
 
-const ScoreType	GameState::LTD2(const IDType & player) const
+// sums over the units in the same order and precision as calculateStartingHealth(), so that a player
+// with every unit at full health evaluates to exactly the same as the starting total
+void GameState::calculateUnitSums()
 {
-	if (numUnits(player) == 0)
+	for (IDType p(0); p<Constants::Num_Players; ++p)
 	{
-		return 0;
-	}
+		float ltdSum(0);
+		float ltd2Sum(0);
+        _numAttackers[p] = 0;
 
-	float sum(0);
+		for (IDType u(0); u<_numUnits[p]; ++u)
+		{
+            const Unit & unit(getUnit(p, u));
 
-	for (IDType u(0); u<numUnits(player); ++u)
-	{
-		const Unit & unit(getUnit(player, u));
+			ltdSum += unit.currentHP() * unit.dpf();
+			ltd2Sum += sqrtf(unit.currentHP()) * unit.dpf();
+            _numAttackers[p] += (unit.damage() > 0);
+		}
 
-		sum += sqrtf(unit.currentHP()) * unit.dpf();
+		_ltdSum[p] = ltdSum;
+		_ltd2Sum[p] = ltd2Sum;
 	}
+}
 
-	ScoreType ret = (ScoreType)(1000 * sum / _totalSumSQRT[player]);
+// called after a unit's hit points have changed from oldHP, a unit whose hit points fell to 0 or below has died
+void GameState::updateUnitSums(const Unit & unit, const HealthType & oldHP)
+{
+    const IDType player(unit.player());
+    const HealthType newHP(std::max(unit.currentHP(), (HealthType)0));
+    const double dpf(unit.dpf());
 
-	return ret;
+    _ltdSum[player]  += (newHP - oldHP) * dpf;
+    _ltd2Sum[player] += ((double)sqrtf(newHP) - (double)sqrtf(oldHP)) * dpf;
+
+    if (!unit.isAlive() && (unit.damage() > 0))
+    {
+        _numAttackers[player]--;
+    }
 }
 
-const ScoreType GameState::LTD(const IDType & player) const
+// checks the running sums against sums over every living unit, the sums can't match exactly
+// since the running ones add the changes in a different order, but they should be very close to
+// each other relative to the starting totals
+void GameState::checkUnitSums(const IDType & player) const
+{
+    double ltdSum(0);
+    double ltd2Sum(0);
+    UnitCountType numAttackers(0);
+
+    for (size_t slot(0); slot < Constants::Max_Units; ++slot)
+    {
+        const Unit & unit(_units[player][slot]);
+
+        if (unit.isAlive())
+        {
+            ltdSum += unit.currentHP() * unit.dpf();
+            ltd2Sum += sqrtf(unit.currentHP()) * unit.dpf();
+            numAttackers += (unit.damage() > 0);
+        }
+    }
+
+    SPARCRAFT_ASSERT(fabs(ltdSum - _ltdSum[player]) <= 0.0001 * (1 + _totalLTD[player]), "Incremental LTD sum %lf does not match full sum %lf", _ltdSum[player], ltdSum);
+    SPARCRAFT_ASSERT(fabs(ltd2Sum - _ltd2Sum[player]) <= 0.0001 * (1 + _totalSumSQRT[player]), "Incremental LTD2 sum %lf does not match full sum %lf", _ltd2Sum[player], ltd2Sum);
+    SPARCRAFT_ASSERT(numAttackers == _numAttackers[player], "Incremental attacker count %d does not match full count %d", (int)_numAttackers[player], (int)numAttackers);
+}
+
+const ScoreType	GameState::LTD2(const IDType & player) const
 {
 	if (numUnits(player) == 0)
 	{
 		return 0;
 	}
 
-	float sum(0);
+#ifdef SPARCRAFT_DEBUG_EVAL
+    checkUnitSums(player);
+#endif
 
-	for (IDType u(0); u<numUnits(player); ++u)
-	{
-		const Unit & unit(getUnit(player, u));
+	return (ScoreType)(1000 * _ltd2Sum[player] / _totalSumSQRT[player]);
+}
 
-		sum += unit.currentHP() * unit.dpf();
+const ScoreType GameState::LTD(const IDType & player) const
+{
+	if (numUnits(player) == 0)
+	{
+		return 0;
 	}
 
-	return (ScoreType)(1000 * sum / _totalLTD[player]);
+#ifdef SPARCRAFT_DEBUG_EVAL
+    checkUnitSums(player);
+#endif
+
+	return (ScoreType)(1000 * _ltdSum[player] / _totalLTD[player]);
 }
 
 void GameState::setMap(Map * map)
@@ -906,6 +1095,8 @@ const bool GameState::bothCanMove() const
 void GameState::setTime(const TimeType & time)
 {
 	_currentTime = time;
+
+    updateUnitGrid();
 }
 
 const int & GameState::getNumMovements(const IDType & player) const
@@ -1085,16 +1276,20 @@ std::string GameState::toStringCompact() const
 	return ss.str();
 }
 
+// writes the state as a single state GameStateFile
 void GameState::write(const std::string & filename) const
 {
-    std::ofstream fout (filename.c_str(), std::ios::out | std::ios::binary); 
-    fout.write((char *)this, sizeof(*this)); 
-    fout.close();
+    GameStateFile::Write(filename, std::vector<GameState>(1, *this));
 }
 
+// reads the first state of a GameStateFile
 void GameState::read(const std::string & filename)
 {
-    std::ifstream fin (filename.c_str(), std::ios::in | std::ios::binary);
-    fin.read((char *)this, sizeof(*this));
-    fin.close();
+    GameStateFile file(filename);
+    if (file.numStates() == 0)
+    {
+        System::FatalError("State File Contains No States: " + filename);
+    }
+
+    file.getState(0, *this);
 }
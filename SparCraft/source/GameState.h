@@ -9,21 +9,30 @@
 #include "GraphViz.hpp"
 #include "Array.hpp"
 #include "Logger.h"
+#include "UnitGrid.hpp"
 #include <memory>
 
 typedef std::shared_ptr<SparCraft::Map> MapPtr;
 
+// uncomment to check the incrementally updated hash against a full recalculation on every call
+//#define SPARCRAFT_DEBUG_HASH
+
+// uncomment to check the incrementally updated LTD / LTD2 sums and attacker counts against a full recalculation on every call
+//#define SPARCRAFT_DEBUG_EVAL
+
 namespace SparCraft
 {
 class GameState 
 {
-    Map *                                                           _map;               
+    friend class GameStateFile;
 
-    std::vector<Unit> _units[Constants::Num_Players];
-    std::vector<int>  _unitIndex[Constants::Num_Players];
+    Map *                                                           _map;               
 
-    Array2D<Unit, Constants::Num_Players, Constants::Max_Units>     _units2;             
-    Array2D<int, Constants::Num_Players, Constants::Max_Units>      _unitIndex2;        
+    // units never move between storage slots, _unitIndex holds the slots sorted by the time they can next act
+    // both are fixed size so that copying a state, which search does for every child, doesn't allocate
+    // units are kept whole rather than split into per-field arrays, since callers hold and modify them through getUnit
+    Array2D<Unit, Constants::Num_Players, Constants::Max_Units>     _units;
+    Array2D<int, Constants::Num_Players, Constants::Max_Units>      _unitIndex;
     Array<Unit, 1>                                                  _neutralUnits;
 
     Array<UnitCountType, Constants::Num_Players>                    _numUnits;
@@ -32,8 +41,22 @@ class GameState
     Array<float, Constants::Num_Players>                            _totalLTD;
     Array<float, Constants::Num_Players>                            _totalSumSQRT;
 
+    // running sums of currentHP * dpf and sqrt(currentHP) * dpf over each player's living units, and how many of
+    // them can attack, updated as units take damage and heal so that evaluation and playerDead() don't loop over units
+    Array<double, Constants::Num_Players>                           _ltdSum;
+    Array<double, Constants::Num_Players>                           _ltd2Sum;
+    Array<UnitCountType, Constants::Num_Players>                    _numAttackers;
+
     Array<int, Constants::Num_Players>                              _numMovements;
     Array<int, Constants::Num_Players>                              _prevHPSum;
+
+    // the xor of the 64 bit hashes of each player's living units, kept up to date by xoring a unit's hash out
+    // before an action changes it and back in afterwards. the two state hashes are its halves
+    Array<unsigned long long, Constants::Num_Players>               _playerHash;
+
+    // units bucketed by their position at the current time, valid from finishedMoving() until a unit acts
+    // queries fall back to scanning every unit while it is invalid
+    UnitGrid                                                        _unitGrid;
 	
     TimeType                                                        _currentTime;
     size_t                                                          _maxUnits;
@@ -45,6 +68,16 @@ class GameState
 
     void                    performAction(const Action & theMove);
 
+    void                    xorUnitHash(const Unit & unit);
+
+    void                    updateUnitGrid();
+    void                    calculateUnitSums();
+    void                    updateUnitSums(const Unit & unit, const HealthType & oldHP);
+    void                    checkUnitSums(const IDType & player)                                    const;
+    const bool              isDetected(const IDType & player, const Unit & unit)                    const;
+    const IDType            getClosestEnemyUnitIndex(const IDType & player, const IDType & unitIndex, bool checkCloaked) const;
+    const IDType            getClosestOurUnitIndex(const IDType & player, const IDType & unitIndex) const;
+
 public:
 
     GameState();
@@ -103,6 +136,7 @@ public:
     // move related functions
     void                    generateMoves(MoveArray & moves, const IDType & playerIndex)            const;
     void                    makeMoves(const std::vector<Action> & moves);
+    void                    makeMoves(const Action * moves, const size_t & numMoves);
     const int &             getNumMovements(const IDType & player)                                  const;
     const IDType            whoCanMove()                                                            const;
     const bool              bothCanMove()                                                           const;
@@ -115,6 +149,7 @@ public:
 
     // hashing functions
     const HashType          calculateHash(const size_t & hashNum)                                   const;
+    const HashType          calculateFullHash(const size_t & hashNum)                               const;
 
     // state i/o functions
     void                    print(int indent = 0) const;
@@ -0,0 +1,318 @@
+#include "GameStateFile.h"
+#include <fstream>
+#include <cstring>
+
+#ifdef WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+using namespace SparCraft;
+
+namespace
+{
+    const char Magic[4] = { 'S', 'C', 'G', 'S' };
+
+    // fixed width little endian encoding, independent of the byte order of the machine
+    void put8(std::vector<unsigned char> & buf, const unsigned int & v)
+    {
+        buf.push_back((unsigned char)(v & 0xFF));
+    }
+
+    void put16(std::vector<unsigned char> & buf, const unsigned int & v)
+    {
+        put8(buf, v);
+        put8(buf, v >> 8);
+    }
+
+    void put32(std::vector<unsigned char> & buf, const unsigned int & v)
+    {
+        put16(buf, v & 0xFFFF);
+        put16(buf, v >> 16);
+    }
+
+    void putFloat(std::vector<unsigned char> & buf, const float & f)
+    {
+        unsigned int v;
+        memcpy(&v, &f, sizeof(v));
+        put32(buf, v);
+    }
+
+    void set64(std::vector<unsigned char> & buf, const size_t & offset, const unsigned long long & v)
+    {
+        for (size_t b(0); b < 8; ++b)
+        {
+            buf[offset + b] = (unsigned char)((v >> (8 * b)) & 0xFF);
+        }
+    }
+
+    const unsigned int get16(const unsigned char * p)
+    {
+        return p[0] | (p[1] << 8);
+    }
+
+    const unsigned int get32(const unsigned char * p)
+    {
+        return get16(p) | (get16(p + 2) << 16);
+    }
+
+    const unsigned long long get64(const unsigned char * p)
+    {
+        return get32(p) | ((unsigned long long)get32(p + 4) << 32);
+    }
+
+    const int getInt(const unsigned char * p)
+    {
+        return (int)get32(p);
+    }
+
+    const short getShort(const unsigned char * p)
+    {
+        return (short)get16(p);
+    }
+
+    const float getFloat(const unsigned char * p)
+    {
+        const unsigned int v(get32(p));
+        float f;
+        memcpy(&f, &v, sizeof(f));
+        return f;
+    }
+}
+
+GameStateFile::GameStateFile(const std::string & filename)
+    : _data(NULL)
+    , _size(0)
+    , _numStates(0)
+#ifdef WIN32
+    , _file(INVALID_HANDLE_VALUE)
+    , _mapping(NULL)
+#else
+    , _file(-1)
+#endif
+{
+#ifdef WIN32
+    _file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    LARGE_INTEGER size;
+    if (_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(_file, &size))
+    {
+        close();
+        System::FatalError("Problem Opening State File: " + filename);
+    }
+
+    _size = (size_t)size.QuadPart;
+    _mapping = CreateFileMappingA(_file, NULL, PAGE_READONLY, 0, 0, NULL);
+    _data = _mapping ? (const unsigned char *)MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+#else
+    _file = open(filename.c_str(), O_RDONLY);
+    struct stat info;
+    if (_file < 0 || fstat(_file, &info) != 0)
+    {
+        close();
+        System::FatalError("Problem Opening State File: " + filename);
+    }
+
+    _size = (size_t)info.st_size;
+    void * data = _size > 0 ? mmap(NULL, _size, PROT_READ, MAP_SHARED, _file, 0) : MAP_FAILED;
+    _data = data == MAP_FAILED ? NULL : (const unsigned char *)data;
+#endif
+
+    if (_data == NULL || _size < Header_Size || memcmp(_data, Magic, sizeof(Magic)) != 0)
+    {
+        close();
+        System::FatalError("Not a SparCraft State File: " + filename);
+    }
+
+    if (get32(_data + 4) != Version || get32(_data + 12) != State_Header_Size || get32(_data + 16) != Unit_Size)
+    {
+        close();
+        System::FatalError("Unsupported SparCraft State File Version: " + filename);
+    }
+
+    _numStates = get32(_data + 8);
+
+    // check every record lies inside the file up front, so reading a state never has to
+    const size_t offsetsEnd(Header_Size + 8 * (_numStates + 1));
+    bool valid(offsetsEnd <= _size);
+    for (size_t s(0); valid && s < _numStates; ++s)
+    {
+        const unsigned char * offsets(_data + Header_Size);
+        const unsigned long long begin(get64(offsets + 8 * s)), end(get64(offsets + 8 * (s + 1)));
+
+        // offsets are only subtracted once they're known to be in order, adding to one could wrap past the check
+        valid = (end <= _size) && (begin >= offsetsEnd) && (begin <= end) && (end - begin >= State_Header_Size)
+             && (end - begin == State_Header_Size + (unsigned long long)Unit_Size * (_data[begin + 8] + _data[begin + 9]))
+             && (_data[begin + 8] <= Constants::Max_Units) && (_data[begin + 9] <= Constants::Max_Units);
+    }
+
+    if (!valid)
+    {
+        close();
+        System::FatalError("Corrupt SparCraft State File: " + filename);
+    }
+}
+
+GameStateFile::~GameStateFile()
+{
+    close();
+}
+
+void GameStateFile::close()
+{
+#ifdef WIN32
+    if (_data)                          { UnmapViewOfFile(_data); }
+    if (_mapping)                       { CloseHandle(_mapping); }
+    if (_file != INVALID_HANDLE_VALUE)  { CloseHandle(_file); }
+    _mapping = NULL;
+    _file = INVALID_HANDLE_VALUE;
+#else
+    if (_data)                          { munmap((void *)_data, _size); }
+    if (_file >= 0)                     { ::close(_file); }
+    _file = -1;
+#endif
+    _data = NULL;
+    _numStates = 0;
+}
+
+const size_t GameStateFile::numStates() const
+{
+    return _numStates;
+}
+
+const unsigned char * GameStateFile::getStateData(const size_t & state) const
+{
+    SPARCRAFT_ASSERT(state < _numStates, "State %d out of range, file has %d states", (int)state, (int)_numStates);
+
+    return _data + get64(_data + Header_Size + 8 * state);
+}
+
+const size_t GameStateFile::numUnits(const size_t & state, const IDType & player) const
+{
+    return getStateData(state)[8 + player];
+}
+
+void GameStateFile::getState(const size_t & state, GameState & gameState) const
+{
+    const unsigned char * data(getStateData(state));
+
+    // the map isn't stored in the file, so the state keeps whichever one it had
+    Map * map(gameState.getMap());
+    gameState = GameState();
+    gameState.setMap(map);
+    gameState._currentTime  = getInt(data);
+    gameState._sameHPFrames = getInt(data + 4);
+
+    for (IDType p(0); p<Constants::Num_Players; ++p)
+    {
+        gameState._numUnits[p]      = data[8 + p];
+        gameState._prevNumUnits[p]  = data[8 + p];
+        gameState._totalLTD[p]      = getFloat(data + 12 + 4 * p);
+        gameState._totalSumSQRT[p]  = getFloat(data + 20 + 4 * p);
+        gameState._numMovements[p]  = getInt(data + 28 + 4 * p);
+        gameState._prevHPSum[p]     = getInt(data + 36 + 4 * p);
+    }
+
+    // units were written in index order, which is already sorted, into the identity slot order of a new state
+    const unsigned char * unitData(data + State_Header_Size);
+    for (IDType p(0); p<Constants::Num_Players; ++p)
+    {
+        for (IDType u(0); u<gameState._numUnits[p]; ++u, unitData += Unit_Size)
+        {
+            Unit unit(BWAPI::UnitType(get16(unitData)), Position(getInt(unitData + 4), getInt(unitData + 8)), unitData[3], p,
+                      getShort(unitData + 12), getShort(unitData + 14), getInt(unitData + 16), getInt(unitData + 20));
+
+            unit.setPreviousAction(Action(unitData[38], unitData[39], unitData[36], unitData[37], Position(getInt(unitData + 40), getInt(unitData + 44))), getInt(unitData + 24));
+            unit.restorePreviousPosition(Position(getInt(unitData + 28), getInt(unitData + 32)));
+
+            SPARCRAFT_ASSERT(unitData[2] == p, "Unit in state file stored under the wrong player");
+            gameState.getUnit(p, u) = unit;
+            gameState.xorUnitHash(gameState.getUnit(p, u));
+        }
+    }
+
+    gameState.calculateUnitSums();
+    gameState.updateUnitGrid();
+}
+
+GameState GameStateFile::getState(const size_t & state) const
+{
+    GameState gameState;
+    getState(state, gameState);
+    return gameState;
+}
+
+void GameStateFile::Write(const std::string & filename, const std::vector<GameState> & states)
+{
+    std::vector<unsigned char> buf;
+
+    buf.insert(buf.end(), Magic, Magic + sizeof(Magic));
+    put32(buf, Version);
+    put32(buf, (unsigned int)states.size());
+    put32(buf, State_Header_Size);
+    put32(buf, Unit_Size);
+    put32(buf, 0);
+
+    // offsets are filled in as each state is written
+    const size_t offsets(buf.size());
+    buf.resize(buf.size() + 8 * (states.size() + 1), 0);
+
+    for (size_t s(0); s < states.size(); ++s)
+    {
+        const GameState & state(states[s]);
+        set64(buf, offsets + 8 * s, buf.size());
+
+        put32(buf, state._currentTime);
+        put32(buf, state._sameHPFrames);
+        put8(buf, state._numUnits[Players::Player_One]);
+        put8(buf, state._numUnits[Players::Player_Two]);
+        put16(buf, 0);
+
+        for (IDType p(0); p<Constants::Num_Players; ++p) { putFloat(buf, state._totalLTD[p]); }
+        for (IDType p(0); p<Constants::Num_Players; ++p) { putFloat(buf, state._totalSumSQRT[p]); }
+        for (IDType p(0); p<Constants::Num_Players; ++p) { put32(buf, state._numMovements[p]); }
+        for (IDType p(0); p<Constants::Num_Players; ++p) { put32(buf, state._prevHPSum[p]); }
+        put32(buf, 0);
+
+        for (IDType p(0); p<Constants::Num_Players; ++p)
+        {
+            for (IDType u(0); u<state._numUnits[p]; ++u)
+            {
+                const Unit & unit(state.getUnit(p, u));
+                const Action & previousAction(unit.previousAction());
+
+                put16(buf, unit.typeID());
+                put8(buf, unit.player());
+                put8(buf, unit.ID());
+                put32(buf, unit.position().x());
+                put32(buf, unit.position().y());
+                put16(buf, (unsigned short)unit.currentHP());
+                put16(buf, (unsigned short)unit.currentEnergy());
+                put32(buf, unit.nextMoveActionTime());
+                put32(buf, unit.nextAttackActionTime());
+                put32(buf, unit.previousActionTime());
+                put32(buf, unit.previousPosition().x());
+                put32(buf, unit.previousPosition().y());
+                put8(buf, previousAction.type());
+                put8(buf, previousAction.index());
+                put8(buf, previousAction.unit());
+                put8(buf, previousAction.player());
+                put32(buf, previousAction.pos().x());
+                put32(buf, previousAction.pos().y());
+            }
+        }
+    }
+
+    set64(buf, offsets + 8 * states.size(), buf.size());
+
+    std::ofstream fout(filename.c_str(), std::ios::out | std::ios::binary);
+    if (!fout.is_open())
+    {
+        System::FatalError("Problem Opening State File: " + filename);
+    }
+
+    fout.write((const char *)&buf[0], buf.size());
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Common.h"
+#include "GameState.h"
+#include <vector>
+#include <string>
+
+namespace SparCraft
+{
+
+// versioned binary snapshots of game states, one file can hold a single state or a whole corpus
+//
+// every value is stored little endian at a fixed offset so files are the same on every platform
+// and can be read in place from a memory mapping, without parsing or copying the whole file:
+//
+//   header        magic "SCGS", u32 version, u32 numStates, u32 stateHeaderSize, u32 unitSize, u32 reserved
+//   offsets       u64 per state plus one, the byte offset of each state record from the start of the file
+//   states        per state: the state header followed by the units of player one and then player two
+//
+// maps and player upgrades aren't part of a state, experiments set those separately
+class GameStateFile
+{
+public:
+
+    enum { Version = 1, Header_Size = 24, State_Header_Size = 48, Unit_Size = 48 };
+
+private:
+
+    const unsigned char *   _data;
+    size_t                  _size;
+    size_t                  _numStates;
+
+#ifdef WIN32
+    void *                  _file;
+    void *                  _mapping;
+#else
+    int                     _file;
+#endif
+
+    const unsigned char *   getStateData(const size_t & state) const;
+    void                    close();
+
+    GameStateFile(const GameStateFile & rhs);
+    GameStateFile & operator = (const GameStateFile & rhs);
+
+public:
+
+    // maps the file into memory and checks its header, states are only decoded when asked for
+    GameStateFile(const std::string & filename);
+    ~GameStateFile();
+
+    const size_t            numStates()                                                 const;
+    const size_t            numUnits(const size_t & state, const IDType & player)       const;
+    void                    getState(const size_t & state, GameState & gameState)       const;
+    GameState               getState(const size_t & state)                              const;
+
+    static void             Write(const std::string & filename, const std::vector<GameState> & states);
+};
+}
@@ -8,6 +8,7 @@ namespace SparCraft
 	{
 		HashType		unitIndexHash[Constants::Num_Players][Constants::Max_Units];
 		HashValues		values[Constants::Num_Hashes];
+		unsigned long long	unitKey[Constants::Num_Players][Num_Unit_Keys];
 	}
 }
 
@@ -17,9 +18,14 @@ const HashType Hash::HashValues::positionHash(const IDType & player, const Posit
 	return hash32shift(hash32shift(unitPositionHash[player] ^ x) ^ y);
 }
 
+const HashType Hash::HashValues::getTimeHash(const TimeType & time) const
+{
+	return hash32shift(currentTimeHash ^ time);
+}
+
 Hash::HashValues::HashValues(int seed)
 {
-	RandomInt rand(std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), Constants::Seed_Hash_Time ? 0 : seed);
+	Random rand(Constants::Seed_Hash_Time ? 0 : seed);
 
 	for (size_t p(0); p<Constants::Num_Players; ++p)
 	{
@@ -35,6 +41,8 @@ Hash::HashValues::HashValues(int seed)
 		unitTypeHash[p]			= rand.nextInt();
 		currentHPHash[p]		= rand.nextInt();
 	}
+
+	currentTimeHash = rand.nextInt();
 }
 
 const HashType Hash::HashValues::getAttackHash (const size_t & player, const size_t & value) const		
@@ -63,6 +71,16 @@ void Hash::initHash()
 {
 	values[0] = HashValues(0);
 	values[1] = HashValues(1);
+
+	Random rand(Constants::Seed_Hash_Time ? 0 : Constants::Num_Hashes);
+
+	for (size_t p(0); p<Constants::Num_Players; ++p)
+	{
+		for (size_t k(0); k<Num_Unit_Keys; ++k)
+		{
+			unitKey[p][k] = rand.next();
+		}
+	}
 }
 
 int Hash::hash32shift(int key)
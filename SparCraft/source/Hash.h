@@ -17,6 +17,7 @@ namespace Hash
 		HashType	timeCanMoveHash[Constants::Num_Players];
 		HashType	unitTypeHash[Constants::Num_Players];
 		HashType	currentHPHash[Constants::Num_Players];
+		HashType	currentTimeHash;
 
 	public:
 
@@ -27,11 +28,22 @@ namespace Hash
 		const HashType getUnitTypeHash		(const size_t & player, const size_t & value) const;
 		const HashType getCurrentHPHash		(const size_t & player, const size_t & value) const;
 		const HashType positionHash			(const IDType & player, const PositionType & x, const PositionType & y) const;
+		const HashType getTimeHash			(const TimeType & time) const;
 	};
 
 	// some data storage
 	extern HashType			unitIndexHash[Constants::Num_Players][Constants::Max_Units];
 	extern HashValues		values[Constants::Num_Hashes];
+
+	// keys for the 64 bit unit hashes that GameState keeps its running hashes with, see Unit::calculateHash
+	enum UnitKeys { UnitIDKey, UnitPositionKey, UnitTimesKey, UnitHPTypeKey, UnitPreviousPositionKey, UnitPreviousTimeKey, Num_Unit_Keys };
+	extern unsigned long long	unitKey[Constants::Num_Players][Num_Unit_Keys];
+
+	// two 32 bit values as one word to hash with a single Random::Get
+	inline unsigned long long pack(const unsigned int high, const unsigned int low)
+	{
+		return ((unsigned long long)high << 32) | low;
+	}
 	
 	// good hashing functions
 	void			initHash();
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Common.h"
+#include "GameState.h"
+#include "Action.h"
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+namespace SparCraft
+{
+
+// history heuristic and killer move tables for alpha-beta move ordering
+//
+// moves are remembered per unit action rather than per move tuple, keyed by the acting unit's player
+// and type, the action type and the target: the target unit's type for attacks and heals, the direction
+// for moves. every action of a move tuple that caused a cutoff gets depth^2 added to its history score,
+// and becomes the killer for its unit type at that ply. a search sorts each unit's actions by these scores,
+// so the first move tuples it tries are made of the actions that caused cutoffs elsewhere in the tree
+class HistoryTable
+{
+public:
+
+    enum { Max_Unit_Types = 256, Num_Targets = 2 * Max_Unit_Types + Constants::Num_Directions + 2, History_Limit = 1 << 30 };
+
+private:
+
+    std::vector<unsigned int>       _history;       // [player][unit type][target]
+    std::vector<unsigned short>     _killers;       // [ply][player][unit type], the killer's target + 1 or 0 for none
+
+    const size_t getUnitSlot(const GameState & state, const Action & action) const
+    {
+        return action.player() * Max_Unit_Types + state.getUnit(action.player(), action.unit()).typeID();
+    }
+
+    const size_t getTarget(const GameState & state, const Action & action) const
+    {
+        switch (action.type())
+        {
+            case ActionTypes::ATTACK:   return state.getUnit(state.getEnemy(action.player()), action.index()).typeID();
+            case ActionTypes::HEAL:     return Max_Unit_Types + state.getUnit(action.player(), action.index()).typeID();
+            case ActionTypes::MOVE:     return 2 * Max_Unit_Types + action.index();
+            case ActionTypes::RELOAD:   return 2 * Max_Unit_Types + Constants::Num_Directions;
+            default:                    return 2 * Max_Unit_Types + Constants::Num_Directions + 1;
+        }
+    }
+
+    void age()
+    {
+        for (size_t i(0); i < _history.size(); ++i)
+        {
+            _history[i] /= 2;
+        }
+    }
+
+public:
+
+    // the tables are only allocated once a search uses them
+    void newSearch()
+    {
+        if (_history.empty())
+        {
+            _history.resize(Constants::Num_Players * Max_Unit_Types * Num_Targets, 0);
+            _killers.resize(Constants::Max_Search_Depth * Constants::Num_Players * Max_Unit_Types, 0);
+        }
+
+        // history from previous searches is still a good guess, but shouldn't outweigh what this one finds
+        age();
+        std::fill(_killers.begin(), _killers.end(), 0);
+    }
+
+    void addCutoff(const GameState & state, const std::vector<Action> & moveVec, const size_t & ply, const size_t & depth)
+    {
+        for (size_t a(0); a < moveVec.size(); ++a)
+        {
+            const size_t unitSlot(getUnitSlot(state, moveVec[a]));
+            const size_t target(getTarget(state, moveVec[a]));
+            unsigned int & history(_history[unitSlot * Num_Targets + target]);
+
+            history += (unsigned int)(depth * depth);
+            _killers[ply * Constants::Num_Players * Max_Unit_Types + unitSlot] = (unsigned short)(target + 1);
+
+            if (history > History_Limit)
+            {
+                age();
+            }
+        }
+    }
+
+    // killers come before everything else, then actions by history score
+    const unsigned int getScore(const GameState & state, const Action & action, const size_t & ply) const
+    {
+        const size_t unitSlot(getUnitSlot(state, action));
+        const size_t target(getTarget(state, action));
+
+        if (_killers[ply * Constants::Num_Players * Max_Unit_Types + unitSlot] == target + 1)
+        {
+            return std::numeric_limits<unsigned int>::max();
+        }
+
+        return _history[unitSlot * Num_Targets + target];
+    }
+};
+}
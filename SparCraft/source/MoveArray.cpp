@@ -28,7 +28,7 @@ void MoveArray::clear()
 // shuffle the MOVE unit actions to prevent bias in experiments
 // this function assumes that all MOVE actions are contiguous in the moves array
 // this should be the case unless you change the move generation ordering
-void MoveArray::shuffleMoveActions()
+void MoveArray::shuffleMoveActions(Random & random)
 {
     // for each unit
     for (size_t u(0); u<numUnits(); ++u)
@@ -67,7 +67,11 @@ void MoveArray::shuffleMoveActions()
         // shuffle the movement actions for this unit
         if (moveEnd != -1 && moveBegin != -1 && moveEnd != moveBegin)
         {
-            std::random_shuffle(&_moves[u][moveBegin], &_moves[u][moveEnd]);
+            for (int a(moveEnd - 1); a > moveBegin; --a)
+            {
+                std::swap(_moves[u][a], _moves[u][moveBegin + random.nextInt(a - moveBegin + 1)]);
+            }
+
             resetMoveIterator();
         }
     }
@@ -4,6 +4,7 @@
 #include "Array.hpp"
 #include "Unit.h"
 #include "Action.h"
+#include "Random.hpp"
 
 namespace SparCraft
 {
@@ -58,7 +59,42 @@ public:
 
 	void addUnit();
 
-    void shuffleMoveActions();
+    void shuffleMoveActions(Random & random);
+
+    // sorts each unit's moves by moveScore(move), highest first, moves with equal scores keep their order
+    // the move iterator then starts with the tuple of every unit's best move
+    template <class F>
+    void sortMoves(F & moveScore)
+    {
+        Array<unsigned int, Constants::Max_Moves> scores;
+
+        for (size_t u(0); u<numUnits(); ++u)
+        {
+            for (size_t m(0); m<numMoves(u); ++m)
+            {
+                scores[m] = moveScore(_moves[u][m]);
+            }
+
+            // insertion sort, units only have a handful of moves
+            for (size_t m(1); m<numMoves(u); ++m)
+            {
+                const Action move(_moves[u][m]);
+                const unsigned int score(scores[m]);
+
+                size_t i(m);
+                for (; (i > 0) && (scores[i-1] < score); --i)
+                {
+                    _moves[u][i] = _moves[u][i-1];
+                    scores[i] = scores[i-1];
+                }
+
+                _moves[u][i] = move;
+                scores[i] = score;
+            }
+        }
+
+        resetMoveIterator();
+    }
 
 	const size_t & numUnits()						const;
 	const size_t & numUnitsInTuple()				const;
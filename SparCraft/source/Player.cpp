@@ -17,3 +17,8 @@ void Player::setID(const IDType & playerID)
 {
 	_playerID = playerID;
 }
+
+void Player::setSeed(const unsigned long long & seed)
+{
+	_random.seed(seed);
+}
@@ -4,6 +4,7 @@
 #include "GameState.h"
 #include "MoveArray.h"
 #include "Unit.h"
+#include "Random.hpp"
 #include <memory>
 
 namespace SparCraft
@@ -15,10 +16,12 @@ class Player
 {
 protected:
     IDType _playerID;
+    Random _random;         // the player's own random sequence, set per game by Game::setSeed
 public:
     virtual void		getMoves(GameState & state, const MoveArray & moves, std::vector<Action> & moveVec);
     const IDType        ID();
     void                setID(const IDType & playerid);
+    void                setSeed(const unsigned long long & seed);
     virtual IDType      getType() { return PlayerModels::None; }
 };
 
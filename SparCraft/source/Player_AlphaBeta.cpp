@@ -41,9 +41,21 @@ void Player_AlphaBeta::setTranspositionTable(TTPtr table)
 	TT = table;
 }
 
+void Player_AlphaBeta::setNumThreads(const size_t & threads)
+{
+	_params.setNumThreads(threads);
+	alphaBeta->getParams().setNumThreads(threads);
+}
+
+const size_t & Player_AlphaBeta::numThreads() const
+{
+	return _params.numThreads();
+}
+
 void Player_AlphaBeta::getMoves(GameState & state, const MoveArray & moves, std::vector<Action> & moveVec)
 {
     moveVec.clear();
+	alphaBeta->setSeed(_random.next());
 	alphaBeta->doSearch(state);
     moveVec.assign(alphaBeta->getResults().bestMoves.begin(), alphaBeta->getResults().bestMoves.end());
 }
@@ -30,6 +30,8 @@ public:
 	void setParameters(AlphaBetaSearchParameters & p);
 	AlphaBetaSearchParameters & getParams();
 	void setTranspositionTable(TTPtr table);
+	void setNumThreads(const size_t & threads);
+	const size_t & numThreads() const;
 	AlphaBetaSearchResults & results();
 	IDType getType() { return PlayerModels::AlphaBeta; }
 };
@@ -10,19 +10,36 @@ Player_PortfolioGreedySearch::Player_PortfolioGreedySearch (const IDType & playe
 	_seed = PlayerModels::NOKDPS;
 }
 
-Player_PortfolioGreedySearch::Player_PortfolioGreedySearch (const IDType & playerID, const IDType & seed, const size_t & iter, const size_t & responses, const size_t & timeLimit)
+Player_PortfolioGreedySearch::Player_PortfolioGreedySearch (const IDType & playerID, const IDType & seed, const size_t & iter, const size_t & responses, const size_t & timeLimit, const size_t & numThreads)
 {
 	_playerID = playerID;
 	_iterations = iter;
     _responses = responses;
 	_seed = seed;
     _timeLimit = timeLimit;
+
+    // the pool's threads live as long as the player so searches don't start any
+    if (numThreads > 1)
+    {
+        _threadPool = std::shared_ptr<ThreadPool>(new ThreadPool(numThreads));
+    }
+}
+
+PortfolioGreedySearchResults & Player_PortfolioGreedySearch::results()
+{
+    return _results;
 }
 
 void Player_PortfolioGreedySearch::getMoves(GameState & state, const MoveArray & moves, std::vector<Action> & moveVec)
 {
     moveVec.clear();
-	PortfolioGreedySearch pgs(_playerID, _seed, _iterations, _responses, _timeLimit);
 
-	moveVec = pgs.search(_playerID, state);
+    if (!_search)
+    {
+	    _search = std::shared_ptr<PortfolioGreedySearch>(new PortfolioGreedySearch(_playerID, _seed, _iterations, _responses, _timeLimit));
+        _search->setThreadPool(_threadPool.get());
+    }
+
+	moveVec = _search->search(_playerID, state);
+    _results = _search->getResults();
 }
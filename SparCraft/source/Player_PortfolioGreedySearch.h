@@ -3,19 +3,27 @@
 #include "Common.h"
 #include "Player.h"
 #include "PortfolioGreedySearch.h"
+#include "ThreadPool.hpp"
+#include "PortfolioGreedySearchResults.hpp"
 
 namespace SparCraft
 {
+class PortfolioGreedySearch;
+
 class Player_PortfolioGreedySearch : public Player
 {
 	IDType _seed;
 	size_t _iterations;
     size_t _responses;
     size_t _timeLimit;
+    std::shared_ptr<ThreadPool> _threadPool;
+    std::shared_ptr<PortfolioGreedySearch> _search;     // kept so its playout objects are reused by every search
+    PortfolioGreedySearchResults _results;
 public:
 	Player_PortfolioGreedySearch (const IDType & playerID);
-    Player_PortfolioGreedySearch (const IDType & playerID, const IDType & seed, const size_t & iter, const size_t & responses, const size_t & timeLimit);
+    Player_PortfolioGreedySearch (const IDType & playerID, const IDType & seed, const size_t & iter, const size_t & responses, const size_t & timeLimit, const size_t & numThreads = 1);
 	void getMoves(GameState & state, const MoveArray & moves, std::vector<Action> & moveVec);
+    PortfolioGreedySearchResults & results();
     IDType getType() { return PlayerModels::PortfolioGreedySearch; }
 };
 }
\ No newline at end of file
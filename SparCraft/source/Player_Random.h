@@ -2,8 +2,6 @@
 
 #include "Common.h"
 #include "Player.h"
-#include "Random.hpp"
-
 
 namespace SparCraft
 {
@@ -14,7 +12,6 @@ namespace SparCraft
  `----------------------------------------------------------------------*/
 class Player_Random : public Player
 {
-	RandomInt rand;
 public:
 	Player_Random (const IDType & playerID);
 	void getMoves(GameState & state, const MoveArray & moves, std::vector<Action> & moveVec);
@@ -13,6 +13,8 @@ void Player_UCT::getMoves(GameState & state, const MoveArray & moves, std::vecto
     moveVec.clear();
     
     UCTSearch uct(_params);
+    uct.setMemoryPool(&_memoryPool);
+    uct.setSeed(_random.next());
 
     uct.doSearch(state, moveVec);
     _prevResults = uct.getResults();
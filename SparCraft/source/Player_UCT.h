@@ -12,6 +12,7 @@ class Player_UCT : public Player
 {
     UCTSearchParameters     _params;
     UCTSearchResults        _prevResults;
+    UCTMemoryPool           _memoryPool;
 public:
     Player_UCT (const IDType & playerID, const UCTSearchParameters & params);
 	void getMoves(GameState & state, const MoveArray & moves, std::vector<Action> & moveVec);
@@ -1,19 +1,47 @@
 #include "PortfolioGreedySearch.h"
+#include "Game.h"
 
 using namespace SparCraft;
 
+struct PortfolioGreedySearch::PortfolioScratch
+{
+    Game                    game;
+    UnitScriptData          scriptData;
+    size_t                  playouts;
+
+    PortfolioScratch(const GameState & state)
+        : game(state, 100)
+        , playouts(0)
+    {
+    }
+};
+
 PortfolioGreedySearch::PortfolioGreedySearch(const IDType & player, const IDType & enemyScript, const size_t & iter, const size_t & responses, const size_t & timeLimit)
 	: _player(player)
 	, _enemyScript(enemyScript)
 	, _iterations(iter)
     , _responses(responses)
-    , _totalEvals(0)
     , _timeLimit(timeLimit)
+    , _threadPool(NULL)
 {
 	_playerScriptPortfolio.push_back(PlayerModels::NOKDPS);
 	_playerScriptPortfolio.push_back(PlayerModels::KiterDPS);
 }
 
+PortfolioGreedySearch::~PortfolioGreedySearch()
+{
+}
+
+void PortfolioGreedySearch::setThreadPool(ThreadPool * pool)
+{
+    _threadPool = pool;
+}
+
+PortfolioGreedySearchResults & PortfolioGreedySearch::getResults()
+{
+    return _results;
+}
+
 std::vector<Action> PortfolioGreedySearch::search(const IDType & player, const GameState & state)
 {
     Timer t;
@@ -21,6 +49,23 @@ std::vector<Action> PortfolioGreedySearch::search(const IDType & player, const G
 
     const IDType enemyPlayer(state.getEnemy(player));
 
+    // set up the playout objects for each thread, they are kept between searches so that their buffers stay allocated
+    const size_t numThreads(_threadPool ? _threadPool->numThreads() : 1);
+    if (_scratch.size() != numThreads)
+    {
+        _scratch.clear();
+        for (size_t thread(0); thread < numThreads; ++thread)
+        {
+            _scratch.push_back(std::unique_ptr<PortfolioScratch>(new PortfolioScratch(state)));
+        }
+    }
+
+    for (size_t thread(0); thread < numThreads; ++thread)
+    {
+        _scratch[thread]->playouts = 0;
+    }
+    _scriptScores.resize(_playerScriptPortfolio.size());
+
     // calculate the seed scripts for each player
     // they will be used to seed the initial root search
     IDType seedScript = calculateInitialSeed(player, state);
@@ -55,7 +100,13 @@ std::vector<Action> PortfolioGreedySearch::search(const IDType & player, const G
     GameState copy(state);
     currentScriptData.calculateMoves(player, moves, copy, moveVec);
 
-    _totalEvals = 0;
+    _results = PortfolioGreedySearchResults();
+    _results.timeElapsed = t.getElapsedTimeInMilliSec();
+    _results.numThreads = numThreads;
+    for (size_t thread(0); thread < numThreads; ++thread)
+    {
+        _results.playouts += _scratch[thread]->playouts;
+    }
 
     return moveVec;
 }
@@ -67,6 +118,12 @@ void PortfolioGreedySearch::doPortfolioSearch(const IDType & player, const GameS
 
     // the enemy of this player
     const IDType enemyPlayer(state.getEnemy(player));
+
+    // each thread evaluates its scripts against its own copy of the current script data, with its own script players
+    for (size_t thread(0); thread < _scratch.size(); ++thread)
+    {
+        _scratch[thread]->scriptData.setUnitScripts(currentScriptData);
+    }
     
     for (size_t i(0); i<_iterations; ++i)
     {
@@ -84,14 +141,13 @@ void PortfolioGreedySearch::doPortfolioSearch(const IDType & player, const GameS
 
             const Unit & unit(state.getUnit(player, unitIndex));
 
+            // evaluate the current state given a playout with each of this unit's scripts
+            evalUnitScripts(player, state, unit);
+
             // iterate over each script move that it can execute
             for (size_t sIndex(0); sIndex<_playerScriptPortfolio.size(); ++sIndex)
             {
-                // set the current script for this unit
-                currentScriptData.setUnitScript(unit, _playerScriptPortfolio[sIndex]);
-
-                // evaluate the current state given a playout with these unit scripts
-                StateEvalScore score = eval(player, state, currentScriptData);
+                const StateEvalScore & score = _scriptScores[sIndex];
 
                 // if we have a better score, set it
                 if (sIndex == 0 || score > bestScoreVec[unitIndex])
@@ -103,6 +159,11 @@ void PortfolioGreedySearch::doPortfolioSearch(const IDType & player, const GameS
 
             // set the current vector to the best move for use in future simulations
             currentScriptData.setUnitScript(unit, bestScriptVec[unitIndex]);
+
+            for (size_t thread(0); thread < _scratch.size(); ++thread)
+            {
+                _scratch[thread]->scriptData.setUnitScript(unit, bestScriptVec[unitIndex]);
+            }
         }
     }   
 }
@@ -113,10 +174,13 @@ IDType PortfolioGreedySearch::calculateInitialSeed(const IDType & player, const
     StateEvalScore bestScriptScore;
     const IDType enemyPlayer(state.getEnemy(player));
     
+    // the seed playouts reuse the first thread's script data
+    UnitScriptData & currentScriptData = _scratch[0]->scriptData;
+
     // try each script in the portfolio for each unit as an initial seed
     for (size_t sIndex(0); sIndex<_playerScriptPortfolio.size(); ++sIndex)
     {
-        UnitScriptData currentScriptData;
+        currentScriptData.clear();
     
         // set the player's chosen script initially to the seed choice
         for (size_t unitIndex(0); unitIndex < state.numUnits(player); ++unitIndex)
@@ -131,7 +195,7 @@ IDType PortfolioGreedySearch::calculateInitialSeed(const IDType & player, const
         }
 
         // evaluate the current state given a playout with these unit scripts
-        StateEvalScore score = eval(player, state, currentScriptData);
+        StateEvalScore score = eval(player, state, currentScriptData, *_scratch[0]);
 
         if (sIndex == 0 || score > bestScriptScore)
         {
@@ -143,15 +207,39 @@ IDType PortfolioGreedySearch::calculateInitialSeed(const IDType & player, const
     return bestScript;
 }
 
-StateEvalScore PortfolioGreedySearch::eval(const IDType & player, const GameState & state, UnitScriptData & playerScriptsChosen)
+// evaluates every script in the portfolio for this unit, storing the scores in _scriptScores
+// the playouts don't depend on each other, so with a thread pool they run at once
+void PortfolioGreedySearch::evalUnitScripts(const IDType & player, const GameState & state, const Unit & unit)
 {
-    const IDType enemyPlayer(state.getEnemy(player));
+    auto evalScript = [&](const size_t & sIndex, const size_t & thread)
+    {
+        PortfolioScratch & scratch = *_scratch[thread];
 
-	Game g(state, 100);
+        scratch.scriptData.setUnitScript(unit, _playerScriptPortfolio[sIndex]);
+        _scriptScores[sIndex] = eval(player, state, scratch.scriptData, scratch);
+    };
+
+    if (_threadPool)
+    {
+        _threadPool->run(_playerScriptPortfolio.size(), evalScript);
+    }
+    else
+    {
+        for (size_t sIndex(0); sIndex<_playerScriptPortfolio.size(); ++sIndex)
+        {
+            evalScript(sIndex, 0);
+        }
+    }
+}
+
+StateEvalScore PortfolioGreedySearch::eval(const IDType & player, const GameState & state, UnitScriptData & playerScriptsChosen, PortfolioScratch & scratch)
+{
+	Game & g = scratch.game;
+    g.reset(state);
 
     g.playIndividualScripts(playerScriptsChosen);
 
-    _totalEvals++;
+    scratch.playouts++;
 
 	return g.getState().eval(player, SparCraft::EvaluationMethods::LTD2);
 }
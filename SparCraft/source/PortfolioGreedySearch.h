@@ -6,6 +6,8 @@
 #include "Game.h"
 #include "Action.h"
 #include "UnitScriptData.h"
+#include "ThreadPool.hpp"
+#include "PortfolioGreedySearchResults.hpp"
 #include <memory>
 
 namespace SparCraft
@@ -16,25 +18,38 @@ typedef	std::shared_ptr<Player> PlayerPtr;
 class PortfolioGreedySearch
 {
 protected:
+
+    // objects one thread reuses for every playout it evaluates, defined in the .cpp since Game.h includes this file
+    struct PortfolioScratch;
 	
     const IDType				_player;
     const IDType				_enemyScript;
     const size_t				_iterations;
     const size_t                _responses;
     std::vector<IDType>			_playerScriptPortfolio;
-    size_t                      _totalEvals;
     size_t                      _timeLimit;
+    ThreadPool *                _threadPool;
+    std::vector<std::unique_ptr<PortfolioScratch> > _scratch;
+    std::vector<StateEvalScore> _scriptScores;
+    PortfolioGreedySearchResults _results;
 
     void                        doPortfolioSearch(const IDType & player,const GameState & state,UnitScriptData & currentData);
+    void                        evalUnitScripts(const IDType & player,const GameState & state,const Unit & unit);
     std::vector<Action>     getMoveVec(const IDType & player,const GameState & state,const std::vector<IDType> & playerScripts);
-    StateEvalScore              eval(const IDType & player,const GameState & state,UnitScriptData & playerScriptsChosen);
+    StateEvalScore              eval(const IDType & player,const GameState & state,UnitScriptData & playerScriptsChosen,PortfolioScratch & scratch);
     IDType                      calculateInitialSeed(const IDType & player,const GameState & state);
     void                        setAllScripts(const IDType & player,const GameState & state,UnitScriptData & data,const IDType & script);
 
 public:
 
     PortfolioGreedySearch(const IDType & player, const IDType & enemyScript, const size_t & iter, const size_t & responses, const size_t & timeLimit);
+    ~PortfolioGreedySearch();
     std::vector<Action> search(const IDType & player, const GameState & state);
+
+    // evaluate the scripts of each unit in parallel on this pool, NULL to evaluate them one at a time
+    // units are still improved one after another, so no more threads than portfolio scripts are ever busy
+    void setThreadPool(ThreadPool * pool);
+    PortfolioGreedySearchResults & getResults();
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include "Common.h"
+
+namespace SparCraft
+{
+class PortfolioGreedySearchResults
+{
+
+public:
+
+	unsigned long long          playouts;       // number of script playouts evaluated in the search
+	double                      timeElapsed;	// time elapsed in milliseconds
+    size_t                      numThreads;     // threads the playouts were run on
+
+    std::vector<std::vector<std::string> > _desc;    // 2-column description vector
+
+	PortfolioGreedySearchResults()
+		: playouts              (0)
+		, timeElapsed           (0)
+        , numThreads            (1)
+	{
+	}
+
+    const double playoutsPerSecond() const
+    {
+        return timeElapsed > 0 ? (1000.0 * playouts / timeElapsed) : 0;
+    }
+
+    std::vector<std::vector<std::string> > & getDescription()
+    {
+        _desc.clear();
+        _desc.push_back(std::vector<std::string>());
+        _desc.push_back(std::vector<std::string>());
+
+        std::stringstream ss;
+
+        _desc[0].push_back("Playouts: ");
+        _desc[0].push_back("Playouts/Sec: ");
+        _desc[0].push_back("Threads: ");
+
+        ss << playouts;                     _desc[1].push_back(ss.str()); ss.str(std::string());
+        ss << (int)playoutsPerSecond();     _desc[1].push_back(ss.str()); ss.str(std::string());
+        ss << numThreads;                   _desc[1].push_back(ss.str()); ss.str(std::string());
+
+        return _desc;
+    }
+};
+}
@@ -1,31 +1,59 @@
 #pragma once
 
-#include <ctime>
-#include <limits>
-
 namespace SparCraft
 {
-	class RandomInt;
+	class Random;
 }
-	
-class SparCraft::RandomInt
+
+// counter based random number generator, the n-th number of a sequence is a hash of (seed, n)
+// there is no global state, so every game and search owns its own generator and threads can't
+// disturb each other's sequences, and a new independent generator is just a new seed
+class SparCraft::Random
 {
-	int _seed;
-    int _min;
-    int _max;
+	unsigned long long _seed;
+	unsigned long long _counter;
 
 public:
 
-	RandomInt(int min, int max, int seed)
-        : _seed(seed)
-        , _min(min)
-        , _max(max)
+	Random(const unsigned long long & seed = 0)
+		: _seed(seed)
+		, _counter(0)
+	{
+	}
+
+	// the n-th number of the sequence for a seed, the splitmix64 output function
+	static unsigned long long Get(const unsigned long long & seed, const unsigned long long & n)
+	{
+		unsigned long long z = seed + (n + 1) * 0x9E3779B97F4A7C15ull;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	void seed(const unsigned long long & seed)
+	{
+		_seed = seed;
+		_counter = 0;
+	}
+
+	unsigned long long next()
+	{
+		return Get(_seed, _counter++);
+	}
+
+	unsigned int nextInt()
+	{
+		return (unsigned int)(next() >> 32);
+	}
+
+	// uniform in [0, bound), bound must be greater than 0
+	unsigned int nextInt(const unsigned int & bound)
 	{
-		srand(seed);
+		return (unsigned int)(((next() >> 32) * bound) >> 32);
 	}
 
-	int nextInt()
+	bool nextBool()
 	{
-		return ( rand() % (_max-_min) ) + _min;
+		return (next() >> 63) != 0;
 	}
 };
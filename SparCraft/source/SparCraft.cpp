@@ -13,6 +13,9 @@ namespace SparCraft
         // Initialize Weapon and Unit Property Data
         SparCraft::WeaponProperties::Init();
 	    SparCraft::UnitProperties::Init();
+
+        // Initialize the combat lookup tables built from the property data
+        SparCraft::CombatTable::Init();
     
         // Initialize EnumData Class Types
         SparCraft::EnumDataInit();
@@ -12,6 +12,7 @@
 #include "AllPlayers.h"
 #include "Game.h"
 #include "GameState.h"
+#include "GameStateFile.h"
 #include "AnimationFrameData.h"
 
 namespace SparCraft
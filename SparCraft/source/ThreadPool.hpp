@@ -0,0 +1,139 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace SparCraft
+{
+    class ThreadPool;
+}
+
+// a fixed set of threads which run batches of independent tasks
+// the thread calling run() works on the batch too, so a pool of N threads starts N-1 of its own
+// tasks are handed to run() by reference so that starting a batch never allocates
+class SparCraft::ThreadPool
+{
+    typedef void (*TaskFunction)(void * task, const size_t & taskIndex, const size_t & threadIndex);
+
+    std::vector<std::thread>    _threads;
+    std::mutex                  _mutex;
+    std::condition_variable     _batchStarted;
+    std::condition_variable     _batchFinished;
+
+    TaskFunction                _taskFunction;
+    void *                      _task;
+    size_t                      _numTasks;
+    std::atomic<size_t>         _nextTask;
+    size_t                      _working;       // pool threads still working on the current batch
+    size_t                      _batch;         // incremented for every batch so waiting threads can tell a new one started
+    bool                        _shutdown;
+
+    template <class T>
+    static void callTask(void * task, const size_t & taskIndex, const size_t & threadIndex)
+    {
+        (*static_cast<T *>(task))(taskIndex, threadIndex);
+    }
+
+    void work(const size_t & threadIndex)
+    {
+        size_t taskIndex;
+        while ((taskIndex = _nextTask.fetch_add(1)) < _numTasks)
+        {
+            _taskFunction(_task, taskIndex, threadIndex);
+        }
+    }
+
+    void threadLoop(const size_t threadIndex)
+    {
+        size_t lastBatch(0);
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _batchStarted.wait(lock, [&]() { return _shutdown || (_batch != lastBatch); });
+
+                if (_shutdown)
+                {
+                    return;
+                }
+
+                lastBatch = _batch;
+            }
+
+            work(threadIndex);
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_working == 0)
+            {
+                _batchFinished.notify_one();
+            }
+        }
+    }
+
+    ThreadPool(const ThreadPool & rhs);
+    ThreadPool & operator = (const ThreadPool & rhs);
+
+public:
+
+    ThreadPool(const size_t & numThreads)
+        : _taskFunction     (NULL)
+        , _task             (NULL)
+        , _numTasks         (0)
+        , _nextTask         (0)
+        , _working          (0)
+        , _batch            (0)
+        , _shutdown         (false)
+    {
+        for (size_t t(1); t < numThreads; ++t)
+        {
+            _threads.push_back(std::thread(&ThreadPool::threadLoop, this, t));
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _shutdown = true;
+        }
+
+        _batchStarted.notify_all();
+
+        for (size_t t(0); t < _threads.size(); ++t)
+        {
+            _threads[t].join();
+        }
+    }
+
+    const size_t numThreads() const
+    {
+        return _threads.size() + 1;
+    }
+
+    // calls task(taskIndex, threadIndex) for every taskIndex in [0, numTasks) and returns once they are all done
+    // threadIndex is in [0, numThreads()) so tasks can use per-thread scratch data
+    template <class T>
+    void run(const size_t & numTasks, T & task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _taskFunction   = &callTask<T>;
+            _task           = &task;
+            _numTasks       = numTasks;
+            _working        = _threads.size();
+            _nextTask.store(0);
+            _batch++;
+        }
+
+        _batchStarted.notify_all();
+
+        work(0);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _batchFinished.wait(lock, [&]() { return _working == 0; });
+    }
+};
@@ -1,28 +1,120 @@
 #include "TranspositionTable.h"
+#include <limits>
+#include <new>
 
 using namespace SparCraft;
 
+// layout of the packed entry data, from the lowest bit up
+namespace TTData
+{
+	const int ScoreBits		= 25;
+	const int MovesBits		= 12;
+	const int DepthBits		= 6;
+	const int TypeBits		= 2;
+	const int AgeBits		= 4;
+	const int IndexBits		= 7;
+
+	const int MovesShift	= ScoreBits;
+	const int DepthShift	= MovesShift + MovesBits;
+	const int TypeShift		= DepthShift + DepthBits;
+	const int PlayerShift	= TypeShift + TypeBits;
+	const int AgeShift		= PlayerShift + 1;
+	const int FirstShift	= AgeShift + AgeBits;
+	const int SecondShift	= FirstShift + IndexBits;
+
+	const int MaxScore		= (1 << (ScoreBits - 1)) - 1;
+	const unsigned long long MaxMoves = (1ull << MovesBits) - 1;
+	const unsigned long long MaxAge = (1ull << AgeBits) - 1;
+	const size_t MaxIndex	= (1 << IndexBits) - 1;
+
+	// the low half of the key holds the top of the second hash and the best moves' check bytes
+	const HashType Hash2Mask = 0xFFFF0000;
+
+	const unsigned long long field(const unsigned long long & data, const int shift, const int bits)
+	{
+		return (data >> shift) & ((1ull << bits) - 1);
+	}
+
+	// the score is stored in two's complement in the lowest bits
+	const int score(const unsigned long long & data)
+	{
+		return (int)((long long)(data << (64 - ScoreBits)) >> (64 - ScoreBits));
+	}
+
+	// moves are stored as their child index + 1, moves past the last storable index are dropped
+	const size_t moveIndex(const AlphaBetaMove & move)
+	{
+		return (move.isValid() && (move.index() < MaxIndex)) ? move.index() + 1 : 0;
+	}
+}
+
 TTEntry::TTEntry()
 	: _hash2(0)
 	, _depth(0)
 	, _type(TTEntry::NONE)
+	, _firstPlayer(Players::Player_One)
+	, _firstMoveIndex(0)
+	, _secondMoveIndex(0)
+	, _firstMoveCheck(0)
+	, _secondMoveCheck(0)
 {
 
 }
 
-TTEntry::TTEntry(const HashType & hash2, const StateEvalScore & score, const size_t & depth, const int & type, 
+TTEntry::TTEntry(const HashType & hash2, const StateEvalScore & score, const size_t & depth, const int & type,
 				const IDType & firstPlayer, const AlphaBetaMove & bestFirstMove, const AlphaBetaMove & bestSecondMove)
-	: _hash2(hash2)
+	: _hash2(hash2 & TTData::Hash2Mask)
 	, _score(score)
 	, _depth(depth)
 	, _type(type)
+	, _firstPlayer(firstPlayer)
+	, _firstMoveIndex(TTData::moveIndex(bestFirstMove))
+	, _secondMoveIndex(TTData::moveIndex(bestSecondMove))
+	, _firstMoveCheck(bestFirstMove.check())
+	, _secondMoveCheck(bestSecondMove.check())
+{
+}
+
+// decodes an entry from its packed data and the low half of its key
+TTEntry::TTEntry(const HashType & keyLow, const unsigned long long & data)
+	: _hash2(keyLow & TTData::Hash2Mask)
+	, _score((ScoreType)TTData::score(data), (int)TTData::field(data, TTData::MovesShift, TTData::MovesBits))
+	, _depth((size_t)TTData::field(data, TTData::DepthShift, TTData::DepthBits))
+	, _type((int)TTData::field(data, TTData::TypeShift, TTData::TypeBits))
+	, _firstPlayer((IDType)TTData::field(data, TTData::PlayerShift, 1))
+	, _firstMoveIndex((size_t)TTData::field(data, TTData::FirstShift, TTData::IndexBits))
+	, _secondMoveIndex((size_t)TTData::field(data, TTData::SecondShift, TTData::IndexBits))
+	, _firstMoveCheck((unsigned char)(keyLow >> 8))
+	, _secondMoveCheck((unsigned char)keyLow)
+{
+}
+
+// packs the entry into a single word, leaving the age bits empty
+// the score and number of moves are clamped to fit their fields. the search stores the number of moves counted
+// from the saved state, so only its initial alpha and beta, which are given 1000000 moves, are over the limit
+// and come back with the most moves the field holds
+const unsigned long long TTEntry::getData() const
+{
+	const int score = std::min(std::max((int)_score.val(), -TTData::MaxScore), TTData::MaxScore);
+	const unsigned long long moves = std::min((unsigned long long)std::max(_score.numMoves(), 0), TTData::MaxMoves);
+
+	return    ((unsigned long long)(unsigned int)score & ((1ull << TTData::ScoreBits) - 1))
+			| (moves								<< TTData::MovesShift)
+			| ((unsigned long long)_depth			<< TTData::DepthShift)
+			| ((unsigned long long)_type			<< TTData::TypeShift)
+			| ((unsigned long long)_firstPlayer		<< TTData::PlayerShift)
+			| ((unsigned long long)_firstMoveIndex	<< TTData::FirstShift)
+			| ((unsigned long long)_secondMoveIndex	<< TTData::SecondShift);
+}
+
+const HashType TTEntry::getKeyLow() const
 {
-	_bestMoves[firstPlayer] = TTBestMove(bestFirstMove, bestSecondMove);
+	return _hash2 | ((HashType)_firstMoveCheck << 8) | _secondMoveCheck;
 }
 
 const bool TTEntry::hashMatches(const HashType & hash2) const
 {
-	return hash2 == _hash2;
+	return (hash2 & TTData::Hash2Mask) == _hash2;
 }
 
 const bool TTEntry::isValid() const
@@ -34,177 +126,205 @@ const HashType & TTEntry::getHash()								const { return _hash2; }
 const StateEvalScore & TTEntry::getScore()						const { return _score; }
 const size_t & TTEntry::getDepth()								const { return _depth; }
 const int & TTEntry::getType()									const { return _type;  }
-const TTBestMove & TTEntry::getBestMove(const IDType & player)	const { return _bestMoves[player];  }
-void TTEntry::setBestMove(const IDType &firstPlayer, const AlphaBetaMove & bestFirstMove, const AlphaBetaMove & bestSecondMove)
+
+// whether there was a valid best move for this player: its own move if it moved first, otherwise its response
+const bool TTEntry::hasBestMove(const IDType & player)			const
 {
-	_bestMoves[firstPlayer] = TTBestMove(bestFirstMove, bestSecondMove);
+	return (player == _firstPlayer ? _firstMoveIndex : _secondMoveIndex) != 0;
 }
 
-TranspositionTable::TranspositionTable () 
-	: TT(Constants::Transposition_Table_Size, TTEntry())
-	, size(Constants::Transposition_Table_Size)
-    , collisions(0)
-    , lookups(0)
-    , found(0)
-    , notFound(0)
-	, saves(0)
-	, minIndex(0)
-	, maxIndex(0)
-	, saveOverwriteSelf(0)
-	, saveOverwriteOther(0)
-	, saveEmpty(0)
+// the child index and check byte of the best move for this player, the move vector has to be found again by the search
+const AlphaBetaMove TTEntry::getBestMove(const IDType & player)	const
 {
+	if (!hasBestMove(player))
+	{
+		return AlphaBetaMove();
+	}
+
+	return player == _firstPlayer ? AlphaBetaMove(_firstMoveIndex - 1, _firstMoveCheck) : AlphaBetaMove(_secondMoveIndex - 1, _secondMoveCheck);
 }
-	
-const TTEntry & TranspositionTable::operator [] (const size_t & hash) const
+
+TranspositionTable::TranspositionTable(const size_t & sizeMB)
+	: _buckets(NULL)
+	, _numBuckets(std::max((sizeMB * 1024 * 1024) / sizeof(TTBucket), (size_t)1))
+	, _generation(0)
 {
-	return TT[getIndex(hash)];
+	// buckets are aligned to cache lines so that a lookup touches only one line
+	const size_t lineSize = 64;
+	_memory.reset(new char[_numBuckets * sizeof(TTBucket) + lineSize]);
+	_buckets = (TTBucket *)(((size_t)_memory.get() + lineSize - 1) & ~(lineSize - 1));
+
+	for (size_t b(0); b < _numBuckets; ++b)
+	{
+		new (&_buckets[b]) TTBucket();
+	}
+
+	clear();
 }
 
-const TTEntry & TranspositionTable::get(const size_t & hash) const
+TranspositionTable::~TranspositionTable()
 {
-	return TT[getIndex(hash)];
+	for (size_t b(0); b < _numBuckets; ++b)
+	{
+		_buckets[b].~TTBucket();
+	}
 }
-        
-const size_t TranspositionTable::getSaveIndex(const size_t & index, const HashType & hash2, const size_t & depth) const
-{
-	size_t worstDepth(1000);
-	size_t worstDepthIndex(index);
 
-	// scan ahead to find the best spot to store this entryw
-	for (size_t i(index); (i<(index+Constants::Transposition_Table_Scan)) && (i <TT.size()); ++i)
+void TranspositionTable::clear()
+{
+	for (size_t b(0); b < _numBuckets; ++b)
 	{
-		// if this index holds worse data about the current state, use it to overwrite
-		if (TT[i].getHash() == hash2 && TT[i].getDepth() < depth)
-		{
-			return i;
-		}
-		else if (TT[i].getHash() == hash2 && TT[i].getDepth() > depth)
+		for (size_t s(0); s < Bucket_Size; ++s)
 		{
-			printf("We shouldn't get here\n");
-		}
-		// otherwise if this entry is empty, use it
-		else if (!TT[i].isValid())
-		{
-			return i;
-		}
-		// otherwise if the hashes don't match, check to see how old the data is
-		else if (TT[i].getHash() != hash2)
-		{
-			if (TT[i].getDepth() < worstDepth)
-			{
-				worstDepth = TT[i].getDepth();
-				worstDepthIndex = i;
-			}
+			_buckets[b].slots[s].key.store(0, std::memory_order_relaxed);
+			_buckets[b].slots[s].data.store(0, std::memory_order_relaxed);
 		}
 	}
+}
 
-	return worstDepthIndex;
+void TranspositionTable::newSearch()
+{
+	_generation++;
 }
 
-void TranspositionTable::save(	const HashType & hash1, const HashType & hash2, const StateEvalScore & value, const size_t & depth, const int & type,
-			const IDType & firstPlayer, const AlphaBetaMove & bestFirstMove, const AlphaBetaMove & bestSecondMove)
+// reads the entry in a slot, returning an invalid entry if the slot doesn't hold a whole entry for this bucket's states
+// the slot is checked against hash1 as well, since other states map to the same bucket
+const TTEntry TranspositionTable::read(const TTSlot & slot, const HashType & hash1, unsigned char & age) const
 {
-	size_t indexToSave = getSaveIndex(getIndex(hash1), hash2, depth);
-	TTEntry existing = TT[indexToSave];
+	const unsigned long long key  = slot.key.load(std::memory_order_relaxed);
+	const unsigned long long data = slot.data.load(std::memory_order_relaxed);
+	const unsigned long long hash = key ^ data;
 
-	if (existing.isValid())
-	{
-		if (existing.getHash() == hash2)
-		{
-			saveOverwriteSelf++;
-		}
-		else
-		{
-			saveOverwriteOther++;
-		}
-	}
-	else
+	if ((data == 0) || ((HashType)(hash >> 32) != hash1))
 	{
-		saveEmpty++;
+		return TTEntry();
 	}
 
-	saves++;
-	
-	TT[indexToSave] = TTEntry(hash2, value, depth, type, firstPlayer, bestFirstMove, bestSecondMove);
+	age = (unsigned char)TTData::field(data, TTData::AgeShift, TTData::AgeBits);
+	return TTEntry((HashType)(hash & 0xFFFFFFFFull), data);
 }
 
-TTEntry * TranspositionTable::lookupScan(const HashType & hash1, const HashType & hash2)
+// the lowest valued entry of a bucket is the one to replace, every search of age counts as much as two plies of depth
+const int TranspositionTable::replaceValue(const TTEntry & entry, const unsigned char & age) const
+{
+	const int searchesOld = (int)((_generation - age) & TTData::MaxAge);
+
+	return (int)entry.getDepth() - 2 * searchesOld;
+}
+
+void TranspositionTable::save(	const HashType & hash1, const HashType & hash2, const StateEvalScore & value, const size_t & depth, const int & type,
+			const IDType & firstPlayer, const AlphaBetaMove & bestFirstMove, const AlphaBetaMove & bestSecondMove, TTStats & stats)
 {
-	lookups++;
-	size_t index = getIndex(hash1);
+	TTBucket & bucket = _buckets[getBucket(hash1)];
 
-	// scan to see if this exists anywhere in the next few entries
-	for (size_t i(index); (i<(index+Constants::Transposition_Table_Scan)) && (i <TT.size()); ++i)
+	size_t replace(0);
+	int replaceScore(std::numeric_limits<int>::max());
+	bool replaceSelf(false);
+	bool replaceEmpty(false);
+
+	for (size_t s(0); s < Bucket_Size; ++s)
 	{
-		TTEntry * entry = lookup(i, hash2);
+		unsigned char age(0);
+		const TTEntry entry = read(bucket.slots[s], hash1, age);
 
-		// if it does, return it
-		if (entry)
+		// an older entry for this state is always overwritten
+		if (entry.isValid() && entry.hashMatches(hash2))
+		{
+			replace = s;
+			replaceSelf = true;
+			break;
+		}
+		
+		// otherwise use the first empty slot, or the slot with the least useful entry
+		if (!entry.isValid())
+		{
+			if (!replaceEmpty)
+			{
+				replace = s;
+				replaceEmpty = true;
+			}
+		}
+		else if (!replaceEmpty && (replaceValue(entry, age) < replaceScore))
 		{
-			found++;
-			return entry;
+			replace = s;
+			replaceScore = replaceValue(entry, age);
 		}
 	}
 
-	// otherwise return null
-	notFound++;
-	return NULL;
+	if (replaceSelf)		{ stats.saveOverwriteSelf++; }
+	else if (replaceEmpty)	{ stats.saveEmpty++; }
+	else					{ stats.saveOverwriteOther++; }
+
+	stats.saves++;
+
+	const TTEntry entry(hash2, value, depth, type, firstPlayer, bestFirstMove, bestSecondMove);
+	const unsigned long long data = entry.getData() | (((unsigned long long)_generation & TTData::MaxAge) << TTData::AgeShift);
+
+	bucket.slots[replace].key.store(getKey(hash1, entry) ^ data, std::memory_order_relaxed);
+	bucket.slots[replace].data.store(data, std::memory_order_relaxed);
 }
 
-// look up a value in the transposition table, return NULL if not found or collision
-TTEntry * TranspositionTable::lookup(const size_t & index, const HashType & hash2)
+// look up a state in the transposition table, return false if not found or collision
+const bool TranspositionTable::lookup(const HashType & hash1, const HashType & hash2, TTEntry & entry, TTStats & stats) const
 {
-	if (index < minIndex) minIndex = index;
-	if (index > maxIndex) maxIndex = index;
-	
-	TTEntry tte = TT[index];
+	const TTBucket & bucket = _buckets[getBucket(hash1)];
+	bool collision(false);
 
-	// if there is a valid entry at that location
-	if (TT[index].isValid())
+	stats.lookups++;
+
+	for (size_t s(0); s < Bucket_Size; ++s)
 	{
-		// test for matching secondary hash
-		if (TT[index].hashMatches(hash2))
+		unsigned char age(0);
+		const TTEntry tte = read(bucket.slots[s], hash1, age);
+
+		if (!tte.isValid())
 		{
-			found++;
-			return &TT[index];
+			continue;
 		}
-		// if no match it is a collision
-		else
+
+		// if there is a valid entry with a matching secondary hash, it's this state
+		if (tte.hashMatches(hash2))
 		{
-			//collisions++;
-			return NULL;
+			stats.found++;
+			entry = tte;
+			return true;
 		}
+		
+		// otherwise it's a different state with the same primary hash
+		collision = true;
 	}
-	else
+
+	if (collision)
 	{
-		//notFound++;
-		return NULL;
+		stats.collisions++;
 	}
+
+	stats.notFound++;
+	return false;
 }
-	
-const size_t & TranspositionTable::getSize()		const { return size; }
-const size_t & TranspositionTable::numFound()		const { return found; }	
-const size_t & TranspositionTable::numNotFound()	const { return notFound; }
-const size_t & TranspositionTable::numCollisions()	const { return collisions; }
-const size_t & TranspositionTable::numSaves()		const { return saves; }
-const size_t & TranspositionTable::numLookups()		const { return lookups; }
+
+const size_t TranspositionTable::getSize()		const { return _numBuckets * Bucket_Size; }
+const size_t TranspositionTable::getSizeMB()	const { return (_numBuckets * sizeof(TTBucket)) / (1024 * 1024); }
 
 const size_t TranspositionTable::getUsage() const
 {
 	size_t sum(0);
-	for (size_t i(0); i<TT.size(); ++i)
+	for (size_t b(0); b < _numBuckets; ++b)
 	{
-		if (TT[i].isValid())
+		for (size_t s(0); s < Bucket_Size; ++s)
 		{
-			sum++;
+			if (_buckets[b].slots[s].data.load(std::memory_order_relaxed) != 0)
+			{
+				sum++;
+			}
 		}
 	}
 
 	return sum;
 }
 
-void TranspositionTable::print()
+void TranspositionTable::print(const TTStats & stats) const
 {
-	std::cout << "TT stats: " << lookups << " lookups, " << found << " found, " << notFound << " not found, " << collisions << " collions. " << minIndex << " min, " << maxIndex << " max.\n";
-}
\ No newline at end of file
+	std::cout << "TT stats: " << getSizeMB() << "MB, " << stats.lookups << " lookups, " << stats.found << " found, " << stats.notFound << " not found, " << stats.collisions << " collisions, " 
+			  << stats.saves << " saves, " << stats.saveEmpty << " empty, " << stats.saveOverwriteSelf << " self, " << stats.saveOverwriteOther << " other.\n";
+}
@@ -6,10 +6,22 @@
 #include "Action.h"
 #include "AlphaBetaMove.h"
 #include <memory>
+#include <atomic>
+
+#if defined(_MSC_VER)
+	#include <xmmintrin.h>
+	#define SPARCRAFT_PREFETCH(addr) _mm_prefetch((const char *)(addr), _MM_HINT_T0)
+#else
+	#define SPARCRAFT_PREFETCH(addr) __builtin_prefetch(addr)
+#endif
 
 namespace SparCraft
 {
 
+// a decoded copy of a transposition table entry
+// an entry packs into a 64-bit data word plus the low half of a 64-bit key, so that it can be read and written
+// by several threads without locks. the best moves are kept as their index among the node's children
+// and a check byte of the move vector, only the top 16 bits of the second hash are kept to make room
 class TTEntry
 {	
 public:
@@ -21,14 +33,19 @@ private:
 	HashType			_hash2;
 	StateEvalScore		_score;
 	size_t				_depth;
-	TTBestMove			_bestMoves[2];
 	int					_type;
+	IDType				_firstPlayer;
+	size_t				_firstMoveIndex;	// child index + 1 of the best moves, 0 if there is none
+	size_t				_secondMoveIndex;
+	unsigned char		_firstMoveCheck;
+	unsigned char		_secondMoveCheck;
 
 public:
 
 	TTEntry();
 	TTEntry(const HashType & hash2, const StateEvalScore & score, const size_t & depth, const int & type, 
 			const IDType & firstPlayer, const AlphaBetaMove & bestFirstMove, const AlphaBetaMove & bestSecondMove);
+	TTEntry(const HashType & keyLow, const unsigned long long & data);
 
 	const bool hashMatches(const HashType & hash2) const;
 
@@ -38,8 +55,10 @@ public:
 	const StateEvalScore & getScore()							const;
 	const size_t & getDepth()									const;
 	const int & getType()										const;
-	const TTBestMove & getBestMove(const IDType & player)		const;
-	void setBestMove(const IDType &firstPlayer, const AlphaBetaMove & bestFirstMove, const AlphaBetaMove & bestSecondMove);
+	const bool hasBestMove(const IDType & player)				const;
+	const AlphaBetaMove getBestMove(const IDType & player)		const;
+	const unsigned long long getData()							const;
+	const HashType getKeyLow()									const;
 
 	void print() const
 	{
@@ -52,83 +71,137 @@ class TTLookupValue
 {
 	bool		_found;		// did we find a value?
 	bool		_cut;		// should we produce a cut?
-	TTEntry *	_entry;		// the entry we found
+	TTEntry 	_entry;		// the entry we found
+	StateEvalScore	_score;		// the entry's score for the state it was looked up from
 
 public:
 
 	TTLookupValue()
 		: _found(false)
 		, _cut(false)
-		, _entry(NULL)
 	{
 	}
 
-	TTLookupValue(const bool found, const bool cut, TTEntry * entry)
+	TTLookupValue(const bool found, const bool cut, const TTEntry & entry, const StateEvalScore & score = StateEvalScore())
 		: _found(found)
 		, _cut(cut)
 		, _entry(entry)
+		, _score(score)
 	{
 		
 	}
 
-	const bool found() const	{ return _found; }
-	const bool cut() const		{ return _cut; }
-	TTEntry * entry() const		{ return _entry; }
+	const bool found() const			{ return _found; }
+	const bool cut() const				{ return _cut; }
+	const TTEntry & entry() const		{ return _entry; }
+	const StateEvalScore & score() const	{ return _score; }
+};
+
+// counters for the transposition table activity of one search
+class TTStats
+{
+public:
+
+	size_t	lookups,
+			found,
+			notFound,
+			collisions,
+			saves,
+			saveEmpty,
+			saveOverwriteSelf,
+			saveOverwriteOther;
+
+	TTStats()
+		: lookups(0)
+		, found(0)
+		, notFound(0)
+		, collisions(0)
+		, saves(0)
+		, saveEmpty(0)
+		, saveOverwriteSelf(0)
+		, saveOverwriteOther(0)
+	{
+	}
+
+	void add(const TTStats & rhs)
+	{
+		lookups				+= rhs.lookups;
+		found				+= rhs.found;
+		notFound			+= rhs.notFound;
+		collisions			+= rhs.collisions;
+		saves				+= rhs.saves;
+		saveEmpty			+= rhs.saveEmpty;
+		saveOverwriteSelf	+= rhs.saveOverwriteSelf;
+		saveOverwriteOther	+= rhs.saveOverwriteOther;
+	}
 };
 
+// transposition table which can be shared by several searching threads without locks
+// entries are grouped in cache line sized buckets, a state can only be stored in the bucket its hash maps to
+// each slot holds the packed entry data and the key (the first hash and the entry's key half) xor'd with that data,
+// a slot torn by two threads writing at once no longer validates and is treated as a miss
 class TranspositionTable 
 {
-	//Array<TTEntry, Constants::Transposition_Table_Size>	TT;
-	//TTEntry TT[Constants::Transposition_Table_Size];
-	std::vector<TTEntry> TT;
+public:
 
-	size_t			size;
+	static const size_t	Bucket_Size = 4;
 
-	size_t			minIndex,
-					maxIndex;
+private:
 
-	const size_t getIndex(const HashType & hash1) const
+	struct TTSlot
 	{
-		return hash1 % size; 
+		std::atomic<unsigned long long>	key;
+		std::atomic<unsigned long long>	data;
+	};
+
+	struct TTBucket
+	{
+		TTSlot	slots[Bucket_Size];
+	};
+
+	std::unique_ptr<char[]>	_memory;
+	TTBucket *				_buckets;
+	size_t					_numBuckets;
+	unsigned char			_generation;	// age of the current search, entries from older searches are replaced first
+
+	const size_t getBucket(const HashType & hash1) const
+	{
+		return (size_t)(((unsigned long long)hash1 * _numBuckets) >> 32); 
+	}
+
+	static const unsigned long long getKey(const HashType & hash1, const TTEntry & entry)
+	{
+		return ((unsigned long long)hash1 << 32) | entry.getKeyLow();
 	}
 
+	const TTEntry read(const TTSlot & slot, const HashType & hash1, unsigned char & age) const;
+	const int replaceValue(const TTEntry & entry, const unsigned char & age) const;
+
 public:
 
-	size_t			collisions,
-					lookups, 
-					found, 
-					notFound,
-					saves,
-					saveOverwriteSelf,
-					saveOverwriteOther,
-					saveEmpty;
+	TranspositionTable(const size_t & sizeMB = Constants::Transposition_Table_Size_MB);
+	~TranspositionTable();
 
-	TranspositionTable ();
-	
-	const TTEntry & operator [] (const size_t & hash) const;
+	// starts a new search, entries saved in earlier searches become preferred for replacement
+	void newSearch();
 
-	const TTEntry & get(const size_t & hash) const;
-        
-	void save(const HashType & hash1, const TTEntry & entry) ;
+	// hint that the bucket for this state will be looked up soon
+	void prefetch(const HashType & hash1) const
+	{
+		SPARCRAFT_PREFETCH(&_buckets[getBucket(hash1)]);
+	}
 
 	void save(	const HashType & hash1, const HashType & hash2, const StateEvalScore & value, const size_t & depth, const int & type,
-				const IDType & firstPlayer, const AlphaBetaMove & bestFirstMove, const AlphaBetaMove & bestSecondMove);
+				const IDType & firstPlayer, const AlphaBetaMove & bestFirstMove, const AlphaBetaMove & bestSecondMove, TTStats & stats);
 
-	TTEntry * lookup(const size_t & index, const HashType & hash2);
-	TTEntry * lookupScan(const HashType & hash1, const HashType & hash2);
+	const bool lookup(const HashType & hash1, const HashType & hash2, TTEntry & entry, TTStats & stats) const;
 	
-	const size_t & getSize()		const;
-	const size_t & numFound()		const;	
-	const size_t & numNotFound()	const;
-	const size_t & numCollisions()	const;
-	const size_t & numSaves()		const;
-	const size_t & numLookups()		const;
-
-	const size_t getUsage() const;
-
-	const size_t getSaveIndex(const size_t & index, const HashType & hash2, const size_t & depth) const;
+	const size_t getSize()			const;
+	const size_t getSizeMB()		const;
+	const size_t getUsage()			const;
 
-	void print();
+	void clear();
+	void print(const TTStats & stats) const;
 };
 
 typedef	std::shared_ptr<TranspositionTable> TTPtr;
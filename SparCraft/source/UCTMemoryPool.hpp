@@ -2,54 +2,144 @@
 
 #include "Common.h"
 #include "UCTNode.h"
+#include <memory>
+#include <mutex>
+#include <algorithm>
 
 namespace SparCraft
 {
+    template <class T> class UCTArena;
     class UCTMemoryPool;
 }
 
-class SparCraft::UCTMemoryPool
-{	
-    std::vector< std::vector<UCTNode> > _pool;
+// a growable array addressed by 32-bit index which allocates in fixed size blocks
+// elements never move once allocated, so threads can read the tree while others add to it
+template <class T>
+class SparCraft::UCTArena
+{
+    static const size_t     BlockBits   = 14;
+    static const size_t     BlockSize   = 1 << BlockBits;
+    static const size_t     MaxBlocks   = 4096;
 
-    const size_t    _poolSize;
-    const size_t    _maxChildren;
-    
-    size_t    _currentIndex;
+    std::unique_ptr<T[]>    _blocks[MaxBlocks];
+    size_t                  _numBlocks;
+    size_t                  _size;
+    std::mutex              _mutex;
 
 public:
 
-	UCTMemoryPool(const size_t & poolSize, const size_t & maxChildren)
-        : _pool             (poolSize, std::vector<UCTNode>())
-        , _poolSize         (poolSize)
-        , _maxChildren      (maxChildren)
-        , _currentIndex     (0)
+    UCTArena()
+        : _numBlocks        (0)
+        , _size             (0)
     {
-        for (size_t s(0); s<poolSize; ++s)
-        {
-            _pool[s].reserve(maxChildren);
-        }
     }
 
-    std::vector<UCTNode> * alloc()
+    // returns the index of count contiguous elements, ranges never span two blocks
+    UCTIndex alloc(const size_t & count)
     {
-        std::vector<UCTNode> & ret(_pool[_currentIndex]);
-        if (ret.size() > 0)
+        SPARCRAFT_ASSERT(count <= BlockSize, "UCTArena can't allocate %d contiguous elements", (int)count);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if ((_size & (BlockSize - 1)) + count > BlockSize)
+        {
+            _size = (_size + BlockSize - 1) & ~(BlockSize - 1);
+        }
+
+        while (_size + count > _numBlocks * BlockSize)
         {
-            ret.clear();
+            SPARCRAFT_ASSERT(_numBlocks < MaxBlocks, "UCTArena is out of blocks");
+            _blocks[_numBlocks++].reset(new T[BlockSize]);
         }
 
-        _currentIndex = (_currentIndex + 1) % _poolSize;
-        return &ret;
+        const UCTIndex index = (UCTIndex)_size;
+        _size += count;
+
+        return index;
     }
 
-    void clearPool()
+    T & operator [] (const UCTIndex & index)
+    {
+        return _blocks[index >> BlockBits][index & (BlockSize - 1)];
+    }
+
+    const T & operator [] (const UCTIndex & index) const
     {
-        for (size_t i(0); i<_poolSize; ++i)
+        return _blocks[index >> BlockBits][index & (BlockSize - 1)];
+    }
+
+    const size_t size() const
+    {
+        return _size;
+    }
+
+    // allocated blocks are kept, so this is O(1) and the next tree reuses the memory
+    void clear()
+    {
+        _size = 0;
+    }
+};
+
+// holds every node of a UCT search tree along with the actions of the moves which generated them
+// a Player_UCT keeps one of these for the whole game so searches don't allocate once it has grown
+class SparCraft::UCTMemoryPool
+{
+    UCTArena<UCTNode>       _nodes;
+    UCTArena<Action>        _actions;
+
+public:
+
+    UCTMemoryPool()
+    {
+    }
+
+    UCTIndex allocNodes(const size_t & count)
+    {
+        return _nodes.alloc(count);
+    }
+
+    UCTIndex allocMove(const std::vector<Action> & move)
+    {
+        const UCTIndex index = _actions.alloc(move.size());
+
+        for (size_t a(0); a < move.size(); ++a)
         {
-            _pool[i].clear();
+            _actions[index + (UCTIndex)a] = move[a];
         }
 
-        _currentIndex = 0;
+        return index;
+    }
+
+    UCTNode & getNode(const UCTIndex & index)
+    {
+        return _nodes[index];
+    }
+
+    // the actions of the move which generated a node, NULL if it is empty
+    const Action * getMoveActions(const UCTNode & node) const
+    {
+        return node.getMoveSize() > 0 ? &_actions[node.getMove()] : NULL;
+    }
+
+    void getMove(const UCTNode & node, std::vector<Action> & move) const
+    {
+        const Action * actions = getMoveActions(node);
+        move.assign(actions, actions + node.getMoveSize());
+    }
+
+    const bool sameMove(const UCTNode & a, const UCTNode & b) const
+    {
+        return (a.getMoveSize() == b.getMoveSize()) && std::equal(getMoveActions(a), getMoveActions(a) + a.getMoveSize(), getMoveActions(b));
+    }
+
+    const size_t numNodes() const
+    {
+        return _nodes.size();
+    }
+
+    void clearPool()
+    {
+        _nodes.clear();
+        _actions.clear();
     }
 };
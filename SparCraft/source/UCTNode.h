@@ -2,134 +2,114 @@
 
 #include "Common.h"
 #include "Action.h"
+#include <atomic>
 
 namespace SparCraft
 {
 
+// nodes and the actions of their moves live in a UCTMemoryPool and are referred to by index
+typedef unsigned int UCTIndex;
+
+namespace UCTNodeExpansion
+{
+    enum { NotExpanded, Expanding, Expanded };
+}
 
 class UCTNode
 {
     // uct stat counting variables
-    size_t                      _numVisits;         // total visits to this node
-    double                      _numWins;           // wins from this node
-    double                      _uctVal;            // previous computed UCT value
-            
+    // these are atomic so that several threads can search the same tree
+    std::atomic<unsigned int>   _numVisits;         // total visits to this node
+    std::atomic<unsigned int>   _numHalfWins;       // wins from this node, counted in halves so draws stay exact
+    std::atomic<unsigned int>   _virtualLoss;       // losses added by threads currently searching below this node
+    std::atomic<int>            _expansion;         // whether the children of this node have been generated
+    std::atomic<double>         _uctVal;            // previous computed UCT value
+
     // game specific variables
-    size_t                      _player;            // the player who made a move to generate this node
+    IDType                      _player;            // the player who made a move to generate this node
     IDType                      _nodeType;
-    std::vector<Action>     _move;              // the ove that generated this node
+    unsigned short              _moveSize;          // number of actions in the move that generated this node
+    UCTIndex                    _move;              // index of the first action of that move in the pool
 
-    // holds children
-    std::vector<UCTNode>        _children;
+    // children are stored contiguously in the pool
+    UCTIndex                    _firstChild;
+    unsigned int                _numChildren;
 
     // nodes for traversing the tree
-    UCTNode *                   _parent;
-    
+    UCTIndex                    _parent;
+
+    // nodes are only ever constructed in place by the memory pool
+    UCTNode (const UCTNode & rhs);
+    UCTNode & operator = (const UCTNode & rhs);
+
 public:
 
     UCTNode ()
         : _numVisits            (0)
-        , _numWins              (0)
+        , _numHalfWins          (0)
+        , _virtualLoss          (0)
+        , _expansion            (UCTNodeExpansion::NotExpanded)
         , _uctVal               (0)
         , _player               (Players::Player_None)
         , _nodeType             (SearchNodeType::Default)
-        , _parent               (NULL)
+        , _moveSize             (0)
+        , _move                 (0)
+        , _firstChild           (0)
+        , _numChildren          (0)
+        , _parent               (0)
     {
 
     }
 
-    UCTNode (UCTNode * parent, const IDType player, const IDType nodeType, const std::vector<Action> & move, const size_t & maxChildren, std::vector<UCTNode> * fromPool = NULL)
-        : _numVisits            (0)
-        , _numWins              (0)
-        , _uctVal               (0)
-        , _player               (player)
-        , _nodeType             (nodeType)
-        , _move                 (move)
-        , _parent               (parent)
+    // resets this node for use in a new tree, nodes in the pool are reused between searches
+    void init(const UCTIndex & parent, const IDType & player, const IDType & nodeType, const UCTIndex & move, const size_t & moveSize)
     {
-        _children.reserve(maxChildren);
+        _numVisits.store(0, std::memory_order_relaxed);
+        _numHalfWins.store(0, std::memory_order_relaxed);
+        _virtualLoss.store(0, std::memory_order_relaxed);
+        _expansion.store(UCTNodeExpansion::NotExpanded, std::memory_order_relaxed);
+        _uctVal.store(0, std::memory_order_relaxed);
+
+        _player         = player;
+        _nodeType       = nodeType;
+        _moveSize       = (unsigned short)moveSize;
+        _move           = move;
+        _firstChild     = 0;
+        _numChildren    = 0;
+        _parent         = parent;
     }
 
-    const size_t    numVisits()                 const           { return _numVisits; }
-    const double    numWins()                   const           { return _numWins; }
-    const size_t    numChildren()               const           { return _children.size(); }
-    const double    getUCTVal()                 const           { return _uctVal; }
-    const bool      hasChildren()               const           { return numChildren() > 0; }
+    const size_t    numVisits()                 const           { return _numVisits.load(std::memory_order_relaxed); }
+    const double    numWins()                   const           { return _numHalfWins.load(std::memory_order_relaxed) * 0.5; }
+    const size_t    numVirtualLosses()          const           { return _virtualLoss.load(std::memory_order_relaxed); }
+    const size_t    numChildren()               const           { return _numChildren; }
+    const double    getUCTVal()                 const           { return _uctVal.load(std::memory_order_relaxed); }
+    const bool      hasChildren()               const           { return isExpanded() && (numChildren() > 0); }
+    const bool      isExpanded()                const           { return _expansion.load(std::memory_order_acquire) == UCTNodeExpansion::Expanded; }
     const size_t    getNodeType()               const           { return _nodeType; }
     const IDType    getPlayer()                 const           { return _player; }
 
-    UCTNode *       getParent()                 const           { return _parent; }
-    UCTNode &       getChild(const size_t & c)                  { return _children[c]; }
-
-    void            setUCTVal(double val)                       { _uctVal = val; }
-    void            incVisits()                                 { _numVisits++; }
-    void            addWins(double val)                         { _numWins += val; }
-
-    std::vector<UCTNode> & getChildren()                        { return _children; }
-
-    const std::vector<Action> & getMove() const
-    {
-        return _move;
-    }
-
-    void setMove(const std::vector<Action> & move)
-    {
-        _move = move;
-    }
-
-    void addChild(UCTNode * parent, const IDType player, const IDType nodeType, const std::vector<Action> & move, const size_t & maxChildren, std::vector<UCTNode> * fromPool = NULL)
-    {
-        _children.push_back(UCTNode(parent, player, nodeType, move, maxChildren));
-    }
-
-    UCTNode & mostVisitedChild() 
+    const UCTIndex  getParent()                 const           { return _parent; }
+    const UCTIndex  getChild(const size_t & c)  const           { return _firstChild + (UCTIndex)c; }
+    const UCTIndex  getMove()                   const           { return _move; }
+    const size_t    getMoveSize()               const           { return _moveSize; }
+
+    void            setChildren(const UCTIndex & first, const size_t & num) { _firstChild = first; _numChildren = (unsigned int)num; }
+    void            setUCTVal(double val)                       { _uctVal.store(val, std::memory_order_relaxed); }
+    void            incVisits()                                 { _numVisits.fetch_add(1, std::memory_order_relaxed); }
+    void            addVisits(const size_t & visits)            { _numVisits.fetch_add((unsigned int)visits, std::memory_order_relaxed); }
+    void            addWins(double val)                         { _numHalfWins.fetch_add((unsigned int)(val * 2 + 0.5), std::memory_order_relaxed); }
+    void            addVirtualLoss(const size_t & loss)         { _virtualLoss.fetch_add((unsigned int)loss, std::memory_order_relaxed); }
+    void            removeVirtualLoss(const size_t & loss)      { _virtualLoss.fetch_sub((unsigned int)loss, std::memory_order_relaxed); }
+
+    // only one thread may generate the children of a node, the one for which this returns true
+    // other threads must not touch the children until isExpanded() returns true
+    const bool      beginExpansion()
     {
-        UCTNode * mostVisitedChild = NULL;
-        size_t mostVisits = 0;
-
-       for (size_t c(0); c < numChildren(); ++c)
-       {
-           UCTNode & child = getChild(c);
-
-           if (!mostVisitedChild || (child.numVisits() > mostVisits))
-           {
-               mostVisitedChild = &child;
-               mostVisits = child.numVisits();
-           }
-       }
-
-       return *mostVisitedChild;
+        int expected = UCTNodeExpansion::NotExpanded;
+        return _expansion.compare_exchange_strong(expected, UCTNodeExpansion::Expanding, std::memory_order_acquire);
     }
 
-    UCTNode & bestUCTValueChild(const bool maxPlayer, const UCTSearchParameters & params) 
-    {
-        UCTNode * bestChild = NULL;
-        double bestVal = maxPlayer ? std::numeric_limits<double>::min() : std::numeric_limits<double>::max();
-
-        for (size_t c(0); c < numChildren(); ++c)
-        {
-            UCTNode & child = getChild(c);
-       
-            double winRate      = (double)child.numWins() / (double)child.numVisits();
-            double uctVal       = params.cValue() * sqrt( log( (double)numVisits() ) / ( child.numVisits() ) );
-			double currentVal   = maxPlayer ? (winRate + uctVal) : (winRate - uctVal);
-
-            if (maxPlayer)
-            {
-                if (currentVal > bestVal)
-                {
-                    bestVal             = currentVal;
-			        bestChild           = &child;
-                }
-            }
-            else if (currentVal < bestVal)
-            {
-                bestVal             = currentVal;
-		        bestChild           = &child;
-            }
-        }
-
-        return *bestChild;
-    }
+    void            finishExpansion()                           { _expansion.store(UCTNodeExpansion::Expanded, std::memory_order_release); }
 };
-}
\ No newline at end of file
+}
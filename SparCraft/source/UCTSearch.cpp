@@ -1,10 +1,14 @@
 #include "UCTSearch.h"
+#include <thread>
 
 using namespace SparCraft;
 
 UCTSearch::UCTSearch(const UCTSearchParameters & params) 
 	: _params(params)
+    , _root(0)
     , _memoryPool(NULL)
+    , _virtualLoss(0)
+    , _childMoves(params.maxChildren() + 1)
 {
     for (size_t p(0); p<Constants::Num_Players; ++p)
     {
@@ -27,46 +31,53 @@ void UCTSearch::setMemoryPool(UCTMemoryPool * pool)
     _memoryPool = pool;
 }
 
+void UCTSearch::setSeed(const unsigned long long & seed)
+{
+    _random.seed(seed);
+}
+
 void UCTSearch::doSearch(GameState & initialState, std::vector<Action> & move)
 {
     Timer t;
     t.start();
 
-    _rootNode = UCTNode(NULL, Players::Player_None, SearchNodeType::RootNode, _actionVec, _params.maxChildren(), _memoryPool ? _memoryPool->alloc() : NULL);
-
-    // do the required number of traversals
-    for (size_t traversals(0); traversals < _params.maxTraversals(); ++traversals)
+    if (!_memoryPool)
     {
-        GameState state(initialState);
-        traverse(_rootNode, state);
-
-        if (traversals && (traversals % 5 == 0))
-        {
-            if (_params.timeLimit() && (t.getElapsedTimeInMilliSec() >= _params.timeLimit()))
-            {
-                break;
-            }
-        }
+        _ownMemoryPool = std::shared_ptr<UCTMemoryPool>(new UCTMemoryPool());
+        _memoryPool = _ownMemoryPool.get();
+    }
 
-        _results.traversals++;
+    // throw away the previous tree, its memory is reused for this one
+    _memoryPool->clearPool();
+    _root = newRootNode();
 
-        //printSubTree(_rootNode, initialState, "__uct.txt");
-        //system("\"C:\\Program Files (x86)\\Graphviz2.30\\bin\\dot.exe\" < __uct.txt -Tpng > uct.png");
+    if (_params.numThreads() <= 1)
+    {
+        std::atomic<size_t> traversals(0);
+        runTraversals(initialState, traversals, _params.maxTraversals());
+    }
+    else if (_params.parallelMethod() == UCTParallelMethods::Root)
+    {
+        doRootParallelSearch(initialState);
+    }
+    else
+    {
+        doTreeParallelSearch(initialState);
     }
 
     // choose the move to return
     if (_params.rootMoveSelectionMethod() == UCTMoveSelect::HighestValue)
     {
-        move = _rootNode.bestUCTValueChild(true, _params).getMove();
+        _memoryPool->getMove(bestUCTValueChild(getNode(_root), true), move);
     }
     else if (_params.rootMoveSelectionMethod() == UCTMoveSelect::MostVisited)
     {
-        move = _rootNode.mostVisitedChild().getMove();
+        _memoryPool->getMove(mostVisitedChild(getNode(_root)), move);
     }
 
     if (_params.graphVizFilename().length() > 0)
     {
-        //printSubTree(_rootNode, initialState, _params.graphVizFilename());
+        //printSubTree(getNode(_root), initialState, _params.graphVizFilename());
         //system("\"C:\\Program Files (x86)\\Graphviz2.30\\bin\\dot.exe\" < __uct.txt -Tpng > uct.png");
     }
 
@@ -76,6 +87,170 @@ void UCTSearch::doSearch(GameState & initialState, std::vector<Action> & move)
     //printf("Hello\n");
 }
 
+// do traversals of the tree until the time limit is hit or the shared traversal count reaches maxTraversals
+void UCTSearch::runTraversals(const GameState & initialState, std::atomic<size_t> & traversals, const size_t & maxTraversals)
+{
+    _searchTimer.start();
+
+    for (size_t traversal(traversals++); traversal < maxTraversals; traversal = traversals++)
+    {
+        GameState state(initialState);
+        traverse(_root, state);
+
+        if (traversal && (traversal % 5 == 0) && searchTimeOut())
+        {
+            break;
+        }
+
+        _results.traversals++;
+
+        //printSubTree(getNode(_root), initialState, "__uct.txt");
+        //system("\"C:\\Program Files (x86)\\Graphviz2.30\\bin\\dot.exe\" < __uct.txt -Tpng > uct.png");
+    }
+}
+
+// each thread searches its own tree with its share of the traversals, all trees live in our memory pool
+// the children of the roots are then merged into our root by move, summing their statistics
+void UCTSearch::doRootParallelSearch(const GameState & initialState)
+{
+    const size_t numThreads = _params.numThreads();
+    const size_t maxTraversals = (_params.maxTraversals() + numThreads - 1) / numThreads;
+
+    std::vector< std::unique_ptr<UCTSearch> > searches;
+    std::vector< std::atomic<size_t> > traversals(numThreads);
+    std::vector<UCTIndex> roots;
+    std::vector<std::thread> threads;
+
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        searches.push_back(std::unique_ptr<UCTSearch>(new UCTSearch(_params)));
+        searches[t]->_memoryPool = _memoryPool;
+        searches[t]->setSeed(_random.next());
+        searches[t]->_root = searches[t]->newRootNode();
+        roots.push_back(searches[t]->_root);
+        traversals[t] = 0;
+    }
+
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        threads.push_back(std::thread(&UCTSearch::runTraversals, searches[t].get(), std::cref(initialState), std::ref(traversals[t]), maxTraversals));
+    }
+
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        threads[t].join();
+        addResults(searches[t]->getResults());
+    }
+
+    mergeRootChildren(roots);
+}
+
+// all threads search our tree, sharing the traversal count
+// each thread has its own search object so move generation buffers and scripts are not shared
+void UCTSearch::doTreeParallelSearch(const GameState & initialState)
+{
+    const size_t numThreads = _params.numThreads();
+
+    std::vector< std::unique_ptr<UCTSearch> > searches;
+    std::atomic<size_t> traversals(0);
+    std::vector<std::thread> threads;
+
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        searches.push_back(std::unique_ptr<UCTSearch>(new UCTSearch(_params)));
+        searches[t]->_memoryPool = _memoryPool;
+        searches[t]->setSeed(_random.next());
+        searches[t]->_root = _root;
+        searches[t]->_virtualLoss = _params.virtualLoss();
+    }
+
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        threads.push_back(std::thread(&UCTSearch::runTraversals, searches[t].get(), std::cref(initialState), std::ref(traversals), _params.maxTraversals()));
+    }
+
+    for (size_t t(0); t < numThreads; ++t)
+    {
+        threads[t].join();
+        addResults(searches[t]->getResults());
+    }
+}
+
+// gives our root one child for each distinct move at the root of the given trees
+// with the summed statistics of the children which made that move
+void UCTSearch::mergeRootChildren(const std::vector<UCTIndex> & roots)
+{
+    UCTNode & root = getNode(_root);
+    std::vector<UCTIndex> distinct;
+
+    // find the distinct moves, the merged children share the actions of the first child found with each
+    for (size_t r(0); r < roots.size(); ++r)
+    {
+        UCTNode & otherRoot = getNode(roots[r]);
+
+        for (size_t c(0); otherRoot.hasChildren() && (c < otherRoot.numChildren()); ++c)
+        {
+            bool found = false;
+
+            for (size_t d(0); !found && (d < distinct.size()); ++d)
+            {
+                found = _memoryPool->sameMove(getNode(distinct[d]), getChild(otherRoot, c));
+            }
+
+            if (!found)
+            {
+                distinct.push_back(otherRoot.getChild(c));
+            }
+        }
+    }
+
+    const UCTIndex firstChild = _memoryPool->allocNodes(distinct.size());
+
+    for (size_t d(0); d < distinct.size(); ++d)
+    {
+        const UCTNode & from = getNode(distinct[d]);
+        getNode(firstChild + (UCTIndex)d).init(_root, from.getPlayer(), from.getNodeType(), from.getMove(), from.getMoveSize());
+    }
+
+    root.setChildren(firstChild, distinct.size());
+    root.beginExpansion();
+    root.finishExpansion();
+
+    // sum the statistics into the merged children
+    for (size_t r(0); r < roots.size(); ++r)
+    {
+        UCTNode & otherRoot = getNode(roots[r]);
+
+        root.addVisits(otherRoot.numVisits());
+        root.addWins(otherRoot.numWins());
+
+        for (size_t c(0); otherRoot.hasChildren() && (c < otherRoot.numChildren()); ++c)
+        {
+            UCTNode & otherChild = getChild(otherRoot, c);
+
+            for (size_t d(0); d < distinct.size(); ++d)
+            {
+                UCTNode & child = getChild(root, d);
+
+                if (_memoryPool->sameMove(child, otherChild))
+                {
+                    child.addVisits(otherChild.numVisits());
+                    child.addWins(otherChild.numWins());
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void UCTSearch::addResults(const UCTSearchResults & results)
+{
+    _results.traversals     += results.traversals;
+    _results.nodesVisited   += results.nodesVisited;
+    _results.totalVisits    += results.totalVisits;
+    _results.nodesCreated   += results.nodesCreated;
+}
+
 const bool UCTSearch::searchTimeOut()
 {
 	return (_params.timeLimit() && (_searchTimer.getElapsedTimeInMilliSec() >= _params.timeLimit()));
@@ -184,7 +359,7 @@ const bool UCTSearch::getNextMove(IDType playerToMove, MoveArray & moves, const
 	}
 }
 
-const IDType UCTSearch::getPlayerToMove(UCTNode & node, const GameState & state) const
+const IDType UCTSearch::getPlayerToMove(UCTNode & node, const GameState & state)
 {
 	const IDType whoCanMove(state.whoCanMove());
 
@@ -222,7 +397,7 @@ const IDType UCTSearch::getPlayerToMove(UCTNode & node, const GameState & state)
 		    }
 		    else if (policy == SparCraft::PlayerToMove::Random)
 		    {
-			    return rand() % 2;
+			    return _random.nextInt(2);
 		    }
 
             // we should never get to this state
@@ -236,24 +411,29 @@ const IDType UCTSearch::getPlayerToMove(UCTNode & node, const GameState & state)
 	}
 }
 
-UCTNode & UCTSearch::UCTNodeSelect(UCTNode & parent)
+UCTIndex UCTSearch::UCTNodeSelect(UCTNode & parent)
 {
-    UCTNode *   bestNode    = NULL;
-    bool        maxPlayer   = isRoot(parent) || (parent.getChild(0).getPlayer() == _params.maxPlayer());
+    UCTIndex    bestNode    = parent.getChild(0);
+    bool        maxPlayer   = isRoot(parent) || (getChild(parent, 0).getPlayer() == _params.maxPlayer());
     double      bestVal     = maxPlayer ? std::numeric_limits<double>::min() : std::numeric_limits<double>::max();
          
     // loop through each child to find the best node
     for (size_t c(0); c < parent.numChildren(); ++c)
     {
-        UCTNode & child = parent.getChild(c);
+        UCTNode & child = getChild(parent, c);
 
 		double currentVal(0);
+
+        // virtual losses count as visits which were lost by the player choosing this child
+        const size_t virtualLoss = child.numVirtualLosses();
+        const double numVisits   = (double)(child.numVisits() + virtualLoss);
+        const double numWins     = child.numWins() + (maxPlayer ? 0 : virtualLoss);
 	
         // if we have visited this node already, get its UCT value
-		if (child.numVisits() > 0)
+		if (numVisits > 0)
 		{
-			double winRate    = (double)child.numWins() / (double)child.numVisits();
-            double uctVal     = _params.cValue() * sqrt( log( (double)parent.numVisits() ) / ( child.numVisits() ) );
+			double winRate    = numWins / numVisits;
+            double uctVal     = _params.cValue() * sqrt( log( (double)parent.numVisits() ) / numVisits );
 			currentVal        = maxPlayer ? (winRate + uctVal) : (winRate - uctVal);
             
             child.setUCTVal(currentVal);
@@ -261,7 +441,7 @@ UCTNode & UCTSearch::UCTNodeSelect(UCTNode & parent)
 		else
 		{
             // if we haven't visited it yet, return it and visit immediately
-			return child;
+			return parent.getChild(c);
 		}
 
         // choose the best node depending on max or min player
@@ -270,17 +450,17 @@ UCTNode & UCTSearch::UCTNodeSelect(UCTNode & parent)
             if (currentVal > bestVal)
             {
                 bestVal             = currentVal;
-			    bestNode            = &child;
+			    bestNode            = parent.getChild(c);
             }
         }
         else if (currentVal < bestVal)
         {
             bestVal             = currentVal;
-			bestNode            = &child;
+			bestNode            = parent.getChild(c);
         }
 	}
 
-    return *bestNode;
+    return bestNode;
 }
 
 void UCTSearch::updateState(UCTNode & node, GameState & state, bool isLeaf)
@@ -292,17 +472,18 @@ void UCTSearch::updateState(UCTNode & node, GameState & state, bool isLeaf)
         if (node.getNodeType() == SearchNodeType::SecondSimNode)
         {
             // make the parent's moves on the state because they haven't been done yet
-            state.makeMoves(node.getParent()->getMove());
+            makeMove(getNode(node.getParent()), state);
         }
 
         // do the current node moves and call finished moving
-        state.makeMoves(node.getMove());
+        makeMove(node, state);
         state.finishedMoving();
     }
 }
 
-StateEvalScore UCTSearch::traverse(UCTNode & node, GameState & currentState)
+StateEvalScore UCTSearch::traverse(const UCTIndex & nodeIndex, GameState & currentState)
 {
+    UCTNode & node = getNode(nodeIndex);
     StateEvalScore playoutVal;
 
     _results.totalVisits++;
@@ -332,13 +513,36 @@ StateEvalScore UCTSearch::traverse(UCTNode & node, GameState & currentState)
         else
         {
             // if the children haven't been generated yet
-            if (!node.hasChildren())
+            if (!node.isExpanded())
             {
-                generateChildren(node, currentState);
+                if (node.beginExpansion())
+                {
+                    generateChildren(nodeIndex, currentState);
+                    node.finishExpansion();
+                }
+                // another thread is generating them, which won't take long
+                else
+                {
+                    while (!node.isExpanded())
+                    {
+                        std::this_thread::yield();
+                    }
+                }
             }
 
-            UCTNode & next = UCTNodeSelect(node);
-            playoutVal = traverse(next, currentState);
+            const UCTIndex next = UCTNodeSelect(node);
+
+            // in tree parallel search, make the other threads less likely to follow us down this path
+            if (_virtualLoss)
+            {
+                getNode(next).addVirtualLoss(_virtualLoss);
+                playoutVal = traverse(next, currentState);
+                getNode(next).removeVirtualLoss(_virtualLoss);
+            }
+            else
+            {
+                playoutVal = traverse(next, currentState);
+            }
         }
     }
 
@@ -358,25 +562,38 @@ StateEvalScore UCTSearch::traverse(UCTNode & node, GameState & currentState)
 
 // generate the children of state 'node'
 // state is the GameState after node's moves have been performed
-void UCTSearch::generateChildren(UCTNode & node, GameState & state)
+void UCTSearch::generateChildren(const UCTIndex & nodeIndex, GameState & state)
 {
+    UCTNode & node = getNode(nodeIndex);
+
     // figure out who is next to move in the game
     const IDType playerToMove(getPlayerToMove(node, state));
 
     // generate all the moves possible from this state
 	state.generateMoves(_moveArray, playerToMove);
-    _moveArray.shuffleMoveActions();
+    _moveArray.shuffleMoveActions(_random);
 
     // generate the 'ordered moves' for move ordering
     generateOrderedMoves(state, _moveArray, playerToMove);
 
+    // collect the moves first, since the children have to be allocated next to each other
+    size_t numChildren(0);
+    while ((numChildren < _params.maxChildren()) && getNextMove(playerToMove, _moveArray, numChildren, _childMoves[numChildren]))
+    {
+        ++numChildren;
+    }
+
+    const IDType    childNodeType(getChildNodeType(node, state));
+    const UCTIndex  firstChild(_memoryPool->allocNodes(numChildren));
+
     // for each child of this state, add a child to the current node
-    for (size_t child(0); (child < _params.maxChildren()) && getNextMove(playerToMove, _moveArray, child, _actionVec); ++child)
+    for (size_t child(0); child < numChildren; ++child)
     {
-        // add the child to the tree
-        node.addChild(&node, playerToMove, getChildNodeType(node, state), _actionVec, _params.maxChildren(), _memoryPool ? _memoryPool->alloc() : NULL);
+        getNode(firstChild + (UCTIndex)child).init(nodeIndex, playerToMove, childNodeType, _memoryPool->allocMove(_childMoves[child]), _childMoves[child].size());
         _results.nodesCreated++;
     }
+
+    node.setChildren(firstChild, numChildren);
 }
 
 StateEvalScore UCTSearch::performPlayout(GameState & state)
@@ -389,7 +606,81 @@ StateEvalScore UCTSearch::performPlayout(GameState & state)
 
 const bool UCTSearch::isRoot(UCTNode & node) const
 {
-    return &node == &_rootNode;
+    return node.getNodeType() == SearchNodeType::RootNode;
+}
+
+UCTNode & UCTSearch::getNode(const UCTIndex & index)
+{
+    return _memoryPool->getNode(index);
+}
+
+UCTNode & UCTSearch::getChild(UCTNode & node, const size_t & c)
+{
+    return _memoryPool->getNode(node.getChild(c));
+}
+
+UCTIndex UCTSearch::newRootNode()
+{
+    const UCTIndex root = _memoryPool->allocNodes(1);
+    getNode(root).init(root, Players::Player_None, SearchNodeType::RootNode, 0, 0);
+
+    return root;
+}
+
+// makes the move which generated this node on the given state
+void UCTSearch::makeMove(UCTNode & node, GameState & state)
+{
+    state.makeMoves(_memoryPool->getMoveActions(node), node.getMoveSize());
+}
+
+UCTNode & UCTSearch::mostVisitedChild(UCTNode & node)
+{
+    UCTNode * mostVisitedChild = NULL;
+    size_t mostVisits = 0;
+
+    for (size_t c(0); c < node.numChildren(); ++c)
+    {
+        UCTNode & child = getChild(node, c);
+
+        if (!mostVisitedChild || (child.numVisits() > mostVisits))
+        {
+            mostVisitedChild = &child;
+            mostVisits = child.numVisits();
+        }
+    }
+
+    return *mostVisitedChild;
+}
+
+UCTNode & UCTSearch::bestUCTValueChild(UCTNode & node, const bool maxPlayer)
+{
+    UCTNode * bestChild = NULL;
+    double bestVal = maxPlayer ? std::numeric_limits<double>::min() : std::numeric_limits<double>::max();
+
+    for (size_t c(0); c < node.numChildren(); ++c)
+    {
+        UCTNode & child = getChild(node, c);
+       
+        double winRate      = (double)child.numWins() / (double)child.numVisits();
+        double uctVal       = _params.cValue() * sqrt( log( (double)node.numVisits() ) / ( child.numVisits() ) );
+        double currentVal   = maxPlayer ? (winRate + uctVal) : (winRate - uctVal);
+
+        if (maxPlayer)
+        {
+            if (currentVal > bestVal)
+            {
+                bestVal             = currentVal;
+                bestChild           = &child;
+            }
+        }
+        else if (currentVal < bestVal)
+        {
+            bestVal             = currentVal;
+            bestChild           = &child;
+        }
+    }
+
+    return *bestChild;
 }
 
 void UCTSearch::printSubTree(UCTNode & node, GameState s, std::string filename)
@@ -414,22 +705,22 @@ void UCTSearch::printSubTreeGraphViz(UCTNode & node, GraphViz::Graph & g, GameSt
     {
         if (node.getNodeType() == SearchNodeType::SecondSimNode)
         {
-            state.makeMoves(node.getParent()->getMove());
+            makeMove(getNode(node.getParent()), state);
         }
 
-        state.makeMoves(node.getMove());
+        makeMove(node, state);
         state.finishedMoving();
     }
 
     std::stringstream label;
     std::stringstream move;
 
-    for (size_t a(0); a<node.getMove().size(); ++a)
+    for (size_t a(0); a<node.getMoveSize(); ++a)
     {
-        move << node.getMove()[a].moveString() << "\\n";
+        move << _memoryPool->getMoveActions(node)[a].moveString() << "\\n";
     }
 
-    if (node.getMove().size() == 0)
+    if (node.getMoveSize() == 0)
     {
         move << "root";
     }
@@ -476,7 +767,7 @@ void UCTSearch::printSubTreeGraphViz(UCTNode & node, GraphViz::Graph & g, GameSt
     // recurse for each child
     for (size_t c(0); c<node.numChildren(); ++c)
     {
-        UCTNode & child = node.getChild(c);
+        UCTNode & child = getChild(node, c);
         if (child.numVisits() > 0)
         {
             GraphViz::Edge edge(getNodeIDString(node), getNodeIDString(child));
@@ -16,6 +16,7 @@
 #include "GraphViz.hpp"
 #include "UCTMemoryPool.hpp"
 #include <memory>
+#include <atomic>
 
 namespace SparCraft
 {
@@ -28,16 +29,19 @@ class UCTSearch
 	UCTSearchParameters 	_params;
     UCTSearchResults        _results;
 	Timer		            _searchTimer;
-    UCTNode                 _rootNode;
-    UCTMemoryPool *         _memoryPool;
+    UCTIndex                _root;              // the tree being searched, shared between threads in tree parallel search
+    UCTMemoryPool *         _memoryPool;        // holds the tree, shared between all threads of a search
+    std::shared_ptr<UCTMemoryPool> _ownMemoryPool; // used if no pool was given with setMemoryPool
+    size_t                  _virtualLoss;       // virtual loss applied while descending, 0 unless tree parallel
 
     GameState               _currentState;
+    Random                  _random;
 
 	// we will use these as variables to save stack allocation every time
-    std::vector<Action>                 _actionVec;
 	MoveArray                               _moveArray;
 	Array<std::vector<Action>,
 		 Constants::Max_Ordered_Moves>      _orderedMoves;
+    std::vector< std::vector<Action> >      _childMoves;
 
     std::vector<PlayerPtr>					_allScripts[Constants::Num_Players];
     PlayerPtr                               _playerModels[Constants::Num_Players];
@@ -48,20 +52,35 @@ public:
 
     
     // UCT-specific functions
-    UCTNode &       UCTNodeSelect(UCTNode & parent);
-    StateEvalScore  traverse(UCTNode & node, GameState & currentState);
+    UCTIndex        UCTNodeSelect(UCTNode & parent);
+    StateEvalScore  traverse(const UCTIndex & nodeIndex, GameState & currentState);
 	void            uct(GameState & state, size_t depth, const IDType lastPlayerToMove, std::vector<Action> * firstSimMove);
 
 	void            doSearch(GameState & initialState, std::vector<Action> & move);
+    void            setSeed(const unsigned long long & seed);
+    void            runTraversals(const GameState & initialState, std::atomic<size_t> & traversals, const size_t & maxTraversals);
+
+    // parallel search functions
+    void            doRootParallelSearch(const GameState & initialState);
+    void            doTreeParallelSearch(const GameState & initialState);
+    void            mergeRootChildren(const std::vector<UCTIndex> & roots);
+    void            addResults(const UCTSearchResults & results);
     
+    // Tree functions
+    UCTNode &       getNode(const UCTIndex & index);
+    UCTNode &       getChild(UCTNode & node, const size_t & c);
+    UCTIndex        newRootNode();
+    UCTNode &       mostVisitedChild(UCTNode & node);
+    UCTNode &       bestUCTValueChild(UCTNode & node, const bool maxPlayer);
+
     // Move and Child generation functions
-    void            generateChildren(UCTNode & node, GameState & state);
+    void            generateChildren(const UCTIndex & nodeIndex, GameState & state);
 	void            generateOrderedMoves(GameState & state, MoveArray & moves, const IDType & playerToMove);
     void            makeMove(UCTNode & node, GameState & state);
 	const bool      getNextMove(IDType playerToMove, MoveArray & moves, const size_t & moveNumber, std::vector<Action> & actionVec);
 
     // Utility functions
-	const IDType    getPlayerToMove(UCTNode & node, const GameState & state) const;
+	const IDType    getPlayerToMove(UCTNode & node, const GameState & state);
     const size_t    getChildNodeType(UCTNode & parent, const GameState & prevState) const;
 	const bool      searchTimeOut();
 	const bool      isRoot(UCTNode & node) const;
@@ -26,6 +26,9 @@ class SparCraft::UCTSearchParameters
     IDType          _simScripts[2];                 // NOKDPS               Policy to use for playouts
 	IDType		    _playerToMoveMethod;		    // Alternate			The player to move policy
 	IDType		    _playerModel[2];                // None                 Player model to use for each player
+    size_t          _numThreads;                    // 1                    Number of threads to search with
+    IDType          _parallelMethod;                // Tree                 Root: independent trees merged at the end, Tree: one shared tree
+    size_t          _virtualLoss;                   // 1                    Losses added to a node while a thread is below it in tree parallel search
 
     std::string     _graphVizFilename;              // ""                   File name to output graph viz file
 
@@ -46,6 +49,9 @@ public:
         , _moveOrdering         (MoveOrderMethod::ScriptFirst)
         , _evalMethod           (SparCraft::EvaluationMethods::Playout)
 	    , _playerToMoveMethod   (SparCraft::PlayerToMove::Alternate)
+        , _numThreads           (1)
+        , _parallelMethod       (UCTParallelMethods::Tree)
+        , _virtualLoss          (1)
     {
 	    setPlayerModel(Players::Player_One, PlayerModels::None);
 	    setPlayerModel(Players::Player_Two, PlayerModels::None);
@@ -63,6 +69,9 @@ public:
     const IDType & playerToMoveMethod()				            const   { return _playerToMoveMethod; }
     const IDType & playerModel(const IDType & player)	        const   { return _playerModel[player]; }
     const IDType & rootMoveSelectionMethod()                    const   { return _rootMoveSelection; }
+    const size_t & numThreads()                                 const   { return _numThreads; }
+    const IDType & parallelMethod()                             const   { return _parallelMethod; }
+    const size_t & virtualLoss()                                const   { return _virtualLoss; }
     const std::string & graphVizFilename()                      const   { return _graphVizFilename; }
     const std::vector<IDType> & getOrderedMoveScripts()         const   { return _orderedMoveScripts; }
 	
@@ -79,6 +88,9 @@ public:
     void setGraphVizFilename(const std::string & filename)              { _graphVizFilename = filename; }
     void addOrderedMoveScript(const IDType & script)                    { _orderedMoveScripts.push_back(script); }
     void setPlayerModel(const IDType & player, const IDType & model)	{ _playerModel[player] = model; }	
+    void setNumThreads(const size_t & threads)                          { _numThreads = threads; }
+    void setParallelMethod(const IDType & method)                       { _parallelMethod = method; }
+    void setVirtualLoss(const size_t & loss)                            { _virtualLoss = loss; }
 
     std::vector<std::vector<std::string> > & getDescription()
     {
@@ -97,6 +109,7 @@ public:
             _desc[0].push_back("Move Ordering:");
             _desc[0].push_back("Player To Move:");
             _desc[0].push_back("Opponent Model:");
+            _desc[0].push_back("Threads:");
 
             ss << "UCT";                                                _desc[1].push_back(ss.str()); ss.str(std::string());
             ss << timeLimit() << "ms";                                  _desc[1].push_back(ss.str()); ss.str(std::string());
@@ -106,6 +119,8 @@ public:
             ss << MoveOrderMethod::getName(moveOrderingMethod());         _desc[1].push_back(ss.str()); ss.str(std::string());
             ss << PlayerToMove::getName(playerToMoveMethod());            _desc[1].push_back(ss.str()); ss.str(std::string());
             ss << PlayerModels::getName(playerModel((maxPlayer()+1)%2));  _desc[1].push_back(ss.str()); ss.str(std::string());
+            ss << numThreads() << (numThreads() > 1 ? " " + UCTParallelMethods::getName(parallelMethod()) : "");
+                                                                        _desc[1].push_back(ss.str()); ss.str(std::string());
         }
         
         return _desc;
@@ -21,7 +21,7 @@ Unit::Unit()
 Unit::Unit(const BWAPI::UnitType unitType, const Position & pos, const IDType & unitID, const IDType & playerID, 
            const HealthType & hp, const HealthType & energy, const TimeType & tm, const TimeType & ta) 
     : _unitType             (unitType)
-    , _range                (PlayerWeapon(&PlayerProperties::Get(playerID), unitType.groundWeapon()).GetMaxRange() + Constants::Range_Addition)
+    , _range                (CombatTable::GetRange(playerID, unitType))
     , _position             (pos)
     , _unitID               (unitID)
     , _playerID             (playerID)
@@ -40,7 +40,7 @@ Unit::Unit(const BWAPI::UnitType unitType, const Position & pos, const IDType &
 // constructor for units to construct basic units, sets some things automatically
 Unit::Unit(const BWAPI::UnitType unitType, const IDType & playerID, const Position & pos) 
     : _unitType             (unitType)
-    , _range                (PlayerWeapon(&PlayerProperties::Get(playerID), unitType.groundWeapon()).GetMaxRange() + Constants::Range_Addition)
+    , _range                (CombatTable::GetRange(playerID, unitType))
     , _position             (pos)
     , _unitID               (0)
     , _playerID             (playerID)
@@ -154,19 +154,10 @@ const Position & Unit::position() const
 }
 
 // take an attack, subtract the hp
+// the damage after weapon upgrades, armor, size and multiple hits is looked up in the CombatTable
 void Unit::takeAttack(const Unit & attacker)
 {
-    PlayerWeapon    weapon(attacker.getWeapon(*this));
-    HealthType      damage(weapon.GetDamageBase());
-
-    // calculate the damage based on armor and damage types
-    damage = std::max((int)((damage-getArmor()) * weapon.GetDamageMultiplier(getSize())), 2);
-    
-    // special case where units attack multiple times
-    if (attacker.type() == BWAPI::UnitTypes::Protoss_Zealot || attacker.type() == BWAPI::UnitTypes::Terran_Firebat)
-    {
-        damage *= 2;
-    }
+    const HealthType damage(CombatTable::GetDamageTo(attacker.player(), attacker.type(), _unitType));
 
     //std::cout << type().getName() << " took " << (int)attacker.player() << " " << damage << "\n";
 
@@ -327,6 +318,20 @@ const Position & Unit::currentPosition(const TimeType & gameTime) const
     }
 }
 
+// where the unit was when it last moved, units interpolate between it and position() while moving
+const Position & Unit::previousPosition() const
+{
+    return _previousPosition;
+}
+
+// used when loading a unit which was part way through a move
+void Unit::restorePreviousPosition(const Position & pos)
+{
+    _previousPosition = pos;
+    _prevCurrentPosTime = 0;
+    _prevCurrentPos = pos;
+}
+
 void Unit::setPreviousPosition(const TimeType & gameTime)
 {
     TimeType moveDuration = _timeCanMove - _previousActionTime;
@@ -338,9 +343,7 @@ void Unit::setPreviousPosition(const TimeType & gameTime)
 // returns the damage a unit does
 const HealthType Unit::damage() const	
 { 
-    return _unitType == BWAPI::UnitTypes::Protoss_Zealot ? 
-        2 * (HealthType)_unitType.groundWeapon().damageAmount() : 
-    (HealthType)_unitType.groundWeapon().damageAmount(); 
+    return CombatTable::GetDamage(_unitType);
 }
 
 const HealthType Unit::healAmount() const
@@ -482,7 +485,7 @@ const HealthType Unit::healCost() const
 
 const float Unit::dpf() const 
 { 
-    return (float)std::max(Constants::Min_Unit_DPF, (float)damage() / ((float)attackCooldown() + 1)); 
+    return CombatTable::GetDPF(_unitType); 
 }
 
 const TimeType Unit::moveCooldown() const 
@@ -492,7 +495,7 @@ const TimeType Unit::moveCooldown() const
 
 const TimeType Unit::attackCooldown() const 
 { 
-    return (TimeType)_unitType.groundWeapon().damageCooldown(); 
+    return CombatTable::GetAttackCooldown(_unitType); 
 }
 
 const TimeType Unit::healCooldown() const 
@@ -577,32 +580,48 @@ const std::string Unit::name() const
     return n;
 }
 
-// calculates the hash of this unit based on a given game time
-const HashType Unit::calculateHash(const size_t & hashNum, const TimeType & gameTime) const
+// calculates the hash of this unit
+// all times are absolute so the hash does not change as game time advances, which lets
+// GameState update its hash incrementally. A unit which is moving is hashed by where it
+// came from and when it left so that its current position is implied by the hash
+// the unit ID is hashed too, so the hash of a state doesn't depend on where its units are stored
+// GameState rehashes a unit before and after every action it's in, so each group of fields is packed into
+// one 64 bit word and mixed with a single splitmix step, and both state hashes come from the one result
+const unsigned long long Unit::calculateHash() const
 {
-    Position currentPos = currentPosition(gameTime);
+    const unsigned long long * key(Hash::unitKey[_playerID]);
+
+    unsigned long long hash =   Random::Get(key[Hash::UnitIDKey],       _unitID)
+                              ^ Random::Get(key[Hash::UnitPositionKey], Hash::pack(_position.x(), _position.y()))
+                              ^ Random::Get(key[Hash::UnitTimesKey],    Hash::pack(nextAttackActionTime(), nextMoveActionTime()))
+                              ^ Random::Get(key[Hash::UnitHPTypeKey],   Hash::pack(currentHP(), typeID()));
 
-    return	  Hash::values[hashNum].positionHash(_playerID, currentPos.x(), currentPos.y()) 
-            ^ Hash::values[hashNum].getAttackHash(_playerID, nextAttackActionTime() - gameTime) 
-            ^ Hash::values[hashNum].getMoveHash(_playerID, nextMoveActionTime() - gameTime)
-            ^ Hash::values[hashNum].getCurrentHPHash(_playerID, currentHP())
-            ^ Hash::values[hashNum].getUnitTypeHash(_playerID, typeID());
+    if (_previousAction.type() == ActionTypes::MOVE)
+    {
+        hash ^= Random::Get(key[Hash::UnitPreviousPositionKey], Hash::pack(_previousPosition.x(), _previousPosition.y()))
+              ^ Random::Get(key[Hash::UnitPreviousTimeKey],     (unsigned int)_previousActionTime);
+    }
+
+    return hash;
 }
 
-// calculates the hash of this unit based on a given game time, and prints debug info
-void Unit::debugHash(const size_t & hashNum, const TimeType & gameTime) const
+// calculates the hash of this unit, and prints debug info
+void Unit::debugHash() const
 {
-    std::cout << " Pos   " << Hash::values[hashNum].positionHash(_playerID, position().x(), position().y());
-    std::cout << " Att   " << Hash::values[hashNum].getAttackHash(_playerID, nextAttackActionTime() - gameTime);
-    std::cout << " Mov   " << Hash::values[hashNum].getMoveHash(_playerID, nextMoveActionTime() - gameTime);
-    std::cout << " HP    " << Hash::values[hashNum].getCurrentHPHash(_playerID, currentHP());
-    std::cout << " Typ   " << Hash::values[hashNum].getUnitTypeHash(_playerID, typeID()) << "\n";;
-
-    HashType hash = Hash::values[hashNum].positionHash(_playerID, position().x(), position().y()); std::cout << hash << "\n";
-    hash ^= Hash::values[hashNum].getAttackHash(_playerID, nextAttackActionTime() - gameTime) ; std::cout << hash << "\n";
-    hash ^= Hash::values[hashNum].getMoveHash(_playerID, nextMoveActionTime() - gameTime); std::cout << hash << "\n";
-    hash ^= Hash::values[hashNum].getCurrentHPHash(_playerID, currentHP()); std::cout << hash << "\n";
-    hash ^= Hash::values[hashNum].getUnitTypeHash(_playerID, typeID()); std::cout << hash << "\n";
+    const unsigned long long * key(Hash::unitKey[_playerID]);
+
+    std::cout << " ID    " << Random::Get(key[Hash::UnitIDKey],       _unitID);
+    std::cout << " Pos   " << Random::Get(key[Hash::UnitPositionKey], Hash::pack(position().x(), position().y()));
+    std::cout << " Time  " << Random::Get(key[Hash::UnitTimesKey],    Hash::pack(nextAttackActionTime(), nextMoveActionTime()));
+    std::cout << " HPTyp " << Random::Get(key[Hash::UnitHPTypeKey],   Hash::pack(currentHP(), typeID())) << "\n";
+
+    if (_previousAction.type() == ActionTypes::MOVE)
+    {
+        std::cout << " Prev  " << Random::Get(key[Hash::UnitPreviousPositionKey], Hash::pack(_previousPosition.x(), _previousPosition.y()));
+        std::cout << " PTime " << Random::Get(key[Hash::UnitPreviousTimeKey],     (unsigned int)_previousActionTime) << "\n";
+    }
+
+    std::cout << calculateHash() << "\n";
 }
 
 const std::string Unit::debugString() const
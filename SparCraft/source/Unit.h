@@ -7,6 +7,7 @@
 #include "Hash.h"
 #include "PlayerProperties.h"
 #include "UnitProperties.h"
+#include "CombatTable.h"
 #include "AnimationFrameData.h"
 #include <iostream>
 
@@ -89,6 +90,8 @@ public:
 	const PositionType      getDistanceSqToPosition(const Position & p, const TimeType & gameTime) const;
     const Position &        currentPosition(const TimeType & gameTime) const;
     void                    setPreviousPosition(const TimeType & gameTime);
+    const Position &        previousPosition()          const;
+    void                    restorePreviousPosition(const Position & pos);
 
     // health and damage related functions
 	const HealthType        damage()                    const;
@@ -128,8 +131,8 @@ public:
     const std::string       debugString()               const;
 
 	// hash functions
-	const HashType          calculateHash(const size_t & hashNum, const TimeType & gameTime) const;
-	void                    debugHash(const size_t & hashNum, const TimeType & gameTime) const;
+	const unsigned long long calculateHash()                const;
+	void                    debugHash()                     const;
 };
 
 class UnitPtrCompare
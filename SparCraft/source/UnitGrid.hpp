@@ -0,0 +1,207 @@
+#pragma once
+
+#include "Common.h"
+#include "Array.hpp"
+#include "Position.hpp"
+#include <limits>
+
+namespace SparCraft
+{
+
+// buckets each player's units into a uniform grid of cells by position, so that nearest unit
+// and in range queries only have to look at the cells around a position instead of every unit
+// units are stored by their index in the GameState, grouped by cell into one array per player
+// the grid covers the bounding box of all units and is rebuilt by the state whenever time advances
+class UnitGrid
+{
+public:
+
+    enum { Max_Cells_Per_Side = 16, Max_Cells = Max_Cells_Per_Side * Max_Cells_Per_Side, Min_Cell_Size = 32, Min_Units = 24 };
+
+private:
+
+    PositionType                                                            _x;             // position of the top left corner of the grid
+    PositionType                                                            _y;
+    PositionType                                                            _cellSize;
+    int                                                                     _cols;
+    int                                                                     _rows;
+    bool                                                                    _valid;
+
+    // units of cell c for player p are _units[p][_cellStart[p][c]] up to _units[p][_cellStart[p][c+1]]
+    Array2D<unsigned char, Constants::Num_Players, Max_Cells + 1>           _cellStart;
+    Array2D<unsigned char, Constants::Num_Players, Constants::Max_Units>    _units;
+
+    const int cell(const int & cx, const int & cy) const
+    {
+        return cy * _cols + cx;
+    }
+
+    template <class F>
+    void forEachInCell(const IDType & player, const int & c, F & f) const
+    {
+        for (int i(_cellStart[player][c]); i < _cellStart[player][c + 1]; ++i)
+        {
+            f(_units[player][i]);
+        }
+    }
+
+public:
+
+    UnitGrid()
+        : _x(0)
+        , _y(0)
+        , _cellSize(Min_Cell_Size)
+        , _cols(1)
+        , _rows(1)
+        , _valid(false)
+    {
+        _cellStart.fill(0);
+    }
+
+    // builds the grid from the positions of each player's units, unit u of player p is at positions[p][u]
+    void build(const Array2D<Position, Constants::Num_Players, Constants::Max_Units> & positions, const Array<UnitCountType, Constants::Num_Players> & numUnits)
+    {
+        PositionType minX(std::numeric_limits<PositionType>::max()), minY(std::numeric_limits<PositionType>::max());
+        PositionType maxX(std::numeric_limits<PositionType>::min()), maxY(std::numeric_limits<PositionType>::min());
+
+        for (IDType p(0); p < Constants::Num_Players; ++p)
+        {
+            for (size_t u(0); u < numUnits[p]; ++u)
+            {
+                minX = std::min(minX, positions[p][u].x());
+                minY = std::min(minY, positions[p][u].y());
+                maxX = std::max(maxX, positions[p][u].x());
+                maxY = std::max(maxY, positions[p][u].y());
+            }
+        }
+
+        if (minX > maxX)
+        {
+            minX = maxX = minY = maxY = 0;
+        }
+
+        // cells are made larger rather than adding more of them when the units are spread out
+        const PositionType extent(std::max(maxX - minX, maxY - minY) + 1);
+        _cellSize = std::max((PositionType)Min_Cell_Size, (extent + Max_Cells_Per_Side - 1) / Max_Cells_Per_Side);
+        _x        = minX;
+        _y        = minY;
+        _cols     = (maxX - minX) / _cellSize + 1;
+        _rows     = (maxY - minY) / _cellSize + 1;
+
+        // counting sort of each player's units by cell
+        const int numCells(_cols * _rows);
+        for (IDType p(0); p < Constants::Num_Players; ++p)
+        {
+            for (int c(0); c <= numCells; ++c)
+            {
+                _cellStart[p][c] = 0;
+            }
+
+            for (size_t u(0); u < numUnits[p]; ++u)
+            {
+                _cellStart[p][cell(getCellX(positions[p][u].x()), getCellY(positions[p][u].y())) + 1]++;
+            }
+
+            for (int c(0); c < numCells; ++c)
+            {
+                _cellStart[p][c + 1] += _cellStart[p][c];
+            }
+
+            // place the units, using each cell's start as its insert position and then shifting the starts back
+            for (size_t u(0); u < numUnits[p]; ++u)
+            {
+                const int c(cell(getCellX(positions[p][u].x()), getCellY(positions[p][u].y())));
+                _units[p][_cellStart[p][c]++] = (unsigned char)u;
+            }
+
+            for (int c(numCells); c > 0; --c)
+            {
+                _cellStart[p][c] = _cellStart[p][c - 1];
+            }
+            _cellStart[p][0] = 0;
+        }
+
+        _valid = true;
+    }
+
+    // the grid must be rebuilt once units have acted, since an action can change where a unit currently is
+    void invalidate()
+    {
+        _valid = false;
+    }
+
+    const bool isValid() const
+    {
+        return _valid;
+    }
+
+    // cell coordinates containing a position, positions outside the grid are clamped to the nearest cell
+    const int getCellX(const PositionType & x) const
+    {
+        return std::min(std::max((int)((x - _x) / _cellSize), 0), _cols - 1);
+    }
+
+    const int getCellY(const PositionType & y) const
+    {
+        return std::min(std::max((int)((y - _y) / _cellSize), 0), _rows - 1);
+    }
+
+    // calls f(unitIndex) for every unit of a player in the cells whose chebyshev distance from (cx, cy) is exactly ring
+    template <class F>
+    void forEachInRing(const IDType & player, const int & cx, const int & cy, const int & ring, F & f) const
+    {
+        for (int y(std::max(cy - ring, 0)); y <= std::min(cy + ring, _rows - 1); ++y)
+        {
+            // the top and bottom rows of the ring are whole, the rows between only have their two end cells
+            const bool wholeRow((y == cy - ring) || (y == cy + ring));
+            const int  step(wholeRow ? 1 : std::max(2 * ring, 1));
+
+            for (int x(cx - ring); x <= cx + ring; x += step)
+            {
+                if ((x < 0) || (x >= _cols))
+                {
+                    continue;
+                }
+
+                forEachInCell(player, cell(x, y), f);
+            }
+        }
+    }
+
+    // calls f(unitIndex) for every unit of a player in the cells overlapping the square of the given radius around pos
+    template <class F>
+    void forEachInRadius(const IDType & player, const Position & pos, const PositionType & radius, F & f) const
+    {
+        const int minX(getCellX(pos.x() - radius)), maxX(getCellX(pos.x() + radius));
+        const int minY(getCellY(pos.y() - radius)), maxY(getCellY(pos.y() + radius));
+
+        for (int y(minY); y <= maxY; ++y)
+        {
+            for (int x(minX); x <= maxX; ++x)
+            {
+                forEachInCell(player, cell(x, y), f);
+            }
+        }
+    }
+
+    // whether every cell lies within the given ring of (cx, cy)
+    const bool ringCoversGrid(const int & cx, const int & cy, const int & ring) const
+    {
+        return (cx - ring <= 0) && (cx + ring >= _cols - 1) && (cy - ring <= 0) && (cy + ring >= _rows - 1);
+    }
+
+    // a lower bound on the squared distance from pos, which lies in or was clamped to cell (cx, cy),
+    // to any position in a cell outside the given ring, only sides of the ring with cells beyond them count
+    const PositionType ringOutsideDistanceSq(const Position & pos, const int & cx, const int & cy, const int & ring) const
+    {
+        PositionType dist(std::numeric_limits<PositionType>::max());
+
+        if (cx - ring > 0)          { dist = std::min(dist, pos.x() - (_x + (cx - ring) * _cellSize)); }
+        if (cx + ring < _cols - 1)  { dist = std::min(dist, (_x + (cx + ring + 1) * _cellSize) - pos.x()); }
+        if (cy - ring > 0)          { dist = std::min(dist, pos.y() - (_y + (cy - ring) * _cellSize)); }
+        if (cy + ring < _rows - 1)  { dist = std::min(dist, (_y + (cy + ring + 1) * _cellSize) - pos.y()); }
+
+        return dist == std::numeric_limits<PositionType>::max() ? dist : dist * dist;
+    }
+};
+}
@@ -42,6 +42,7 @@ public:
 	int							GetMaxEnergy(const PlayerProperties & player) const	{ return maxEnergy[player.GetUpgradeLevel(maxEnergyUpgrade)]; }
 	int							GetSight(const PlayerProperties & player) const		{ return sightRange[player.GetUpgradeLevel(sightUpgrade)]; }
 	int							GetSpeed(const PlayerProperties & player) const		{ return speed[player.GetUpgradeLevel(speedUpgrade)]; }
+	BWAPI::UpgradeType			GetExtraArmorUpgrade() const						{ return extraArmorUpgrade; }
 
 	const WeaponProperties &			GetGroundWeapon() const						{ return WeaponProperties::Get(type.groundWeapon()); }
 	const WeaponProperties &			GetAirWeapon() const						{ return WeaponProperties::Get(type.airWeapon()); }
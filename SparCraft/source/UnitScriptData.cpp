@@ -4,6 +4,13 @@ using namespace SparCraft;
 
 UnitScriptData::UnitScriptData() 
 {
+    for (IDType p(0); p < Constants::Num_Players; ++p)
+    {
+        for (IDType s(0); s < PlayerModels::Size; ++s)
+        {
+            _hasScript[p][s] = false;
+        }
+    }
 }
 
 std::vector<Action> & UnitScriptData::getMoves(const IDType & player, const IDType & actualScript)
@@ -19,6 +26,7 @@ Action & UnitScriptData::getMove(const IDType & player, const IDType & unitIndex
 void UnitScriptData::calculateMoves(const IDType & player, MoveArray & moves, GameState & state, std::vector<Action> & moveVec)
 {
     // generate all script moves for this player at this state and store them in allScriptMoves
+    // the move vectors keep their capacity between calls, so once a playout has warmed them up this doesn't allocate
     for (size_t scriptIndex(0); scriptIndex<_scriptVec[player].size(); ++scriptIndex)
     {
         // get the associated player pointer
@@ -48,7 +56,9 @@ void UnitScriptData::calculateMoves(const IDType & player, MoveArray & moves, Ga
 
 const IDType & UnitScriptData::getUnitScript(const IDType & player, const int & id) const
 {
-    return (*_unitScriptMap[player].find(id)).second;
+    SPARCRAFT_ASSERT((id >= 0) && ((size_t)id < _unitScripts[player].size()) && (_unitScripts[player][id] != PlayerModels::Size), "Unit %d has no script", id);
+
+    return _unitScripts[player][id];
 }
     
 const IDType & UnitScriptData::getUnitScript(const Unit & unit) const
@@ -63,27 +73,75 @@ const IDType & UnitScriptData::getScript(const IDType & player, const size_t & i
 
 const PlayerPtr & UnitScriptData::getPlayerPtr(const IDType & player, const size_t & index)
 {
-    return _playerPtrVec[player][index];
+    return _players[player][_scriptVec[player][index]];
 }
 
 const size_t UnitScriptData::getNumScripts(const IDType & player) const
 {
-    return _scriptSet[player].size();
+    return _scriptVec[player].size();
 }
 
-void UnitScriptData::setUnitScript(const IDType & player, const int & id, const IDType & script)
+// marks a script as used by this player, creating this object's player for it the first time
+void UnitScriptData::addScript(const IDType & player, const IDType & script)
 {
-    if (_scriptSet[player].find(script) == _scriptSet[player].end())
+    if (!_hasScript[player][script])
     {
-        _scriptSet[player].insert(script);
+        _hasScript[player][script] = true;
         _scriptVec[player].push_back(script);
-        _playerPtrVec[player].push_back(PlayerPtr(AllPlayers::getPlayerPtr(player, script)));
+
+        if (!_players[player][script])
+        {
+            _players[player][script] = AllPlayers::getPlayerPtr(player, script);
+        }
+    }
+}
+
+void UnitScriptData::setUnitScript(const IDType & player, const int & id, const IDType & script)
+{
+    addScript(player, script);
+
+    // unit IDs are small and dense since the state hands them out in order, units without a script are marked with PlayerModels::Size
+    if ((size_t)id >= _unitScripts[player].size())
+    {
+        _unitScripts[player].resize(id + 1, PlayerModels::Size);
     }
         
-    _unitScriptMap[player][id] = script;
+    _unitScripts[player][id] = script;
 }
 
 void UnitScriptData::setUnitScript(const Unit & unit, const IDType & script)
 {
     setUnitScript(unit.player(), unit.ID(), script);
+}
+
+// copies every unit's script choice, but keeps this object's own script players rather than sharing the other's
+// players hold their own random sequence, so copies used by different threads must not share them
+void UnitScriptData::setUnitScripts(const UnitScriptData & data)
+{
+    clear();
+
+    for (IDType p(0); p < Constants::Num_Players; ++p)
+    {
+        for (size_t s(0); s < data._scriptVec[p].size(); ++s)
+        {
+            addScript(p, data._scriptVec[p][s]);
+        }
+
+        _unitScripts[p] = data._unitScripts[p];
+    }
+}
+
+// removes every unit's script, the players and move buffers are kept for the next scripts set
+void UnitScriptData::clear()
+{
+    for (IDType p(0); p < Constants::Num_Players; ++p)
+    {
+        for (size_t s(0); s < _scriptVec[p].size(); ++s)
+        {
+            _hasScript[p][_scriptVec[p][s]] = false;
+        }
+
+        _scriptVec[p].clear();
+        _unitScripts[p].clear();
+    }
 }
\ No newline at end of file
@@ -6,7 +6,6 @@
 #include "AllPlayers.h"
 #include "Action.h"
 #include <memory>
-#include <set>
 
 namespace SparCraft
 {
@@ -16,11 +15,12 @@ typedef	std::shared_ptr<Player> PlayerPtr;
 
 class UnitScriptData
 {
-    // map from UnitID to PlayerModel
-    std::map<int, IDType>   _unitScriptMap[2];
-    std::set<IDType>        _scriptSet[2];
+    // PlayerModel of each unit, indexed by UnitID
+    // these are flat arrays rather than maps since calculateMoves looks up every unit each round of a playout
+    std::vector<IDType>     _unitScripts[2];
+    bool                    _hasScript[2][PlayerModels::Size];
     std::vector<IDType>     _scriptVec[2];
-    std::vector<PlayerPtr>  _playerPtrVec[2];
+    PlayerPtr               _players[2][PlayerModels::Size];    // created the first time a script is used, then kept
     
    
     std::vector<Action>       _allScriptMoves[2][PlayerModels::Size];
@@ -29,6 +29,8 @@ class UnitScriptData
 
     Action & getMove(const IDType & player, const IDType & unitIndex, const IDType & actualScript);
 
+    void addScript(const IDType & player, const IDType & script);
+
 public:
 
     UnitScriptData();
@@ -36,6 +38,8 @@ public:
     void calculateMoves(const IDType & player, MoveArray & moves, GameState & state, std::vector<Action> & moveVec);
     void setUnitScript(const IDType & player, const int & id, const IDType & script);
     void setUnitScript(const Unit & unit, const IDType & script);
+    void setUnitScripts(const UnitScriptData & data);
+    void clear();
 
     const IDType &      getUnitScript(const IDType & player, const int & id) const;
     const IDType &      getUnitScript(const Unit & unit) const;
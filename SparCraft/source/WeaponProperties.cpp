@@ -89,6 +89,11 @@ int WeaponProperties::GetMaxRange(const PlayerProperties & player) const
     return maxRange[player.GetUpgradeLevel(rangeUpgrade)];
 }
 
+BWAPI::UpgradeType WeaponProperties::GetRangeUpgrade() const 
+{ 
+    return rangeUpgrade;
+}
+
 const WeaponProperties & WeaponProperties::Get(BWAPI::WeaponType type) 
 { 
     return props[type.getID()]; 
@@ -33,6 +33,7 @@ public:
 	float						GetDamageMultiplier(BWAPI::UnitSizeType targetSize) const;
 	int							GetCooldown(const PlayerProperties & player) const;
 	int							GetMaxRange(const PlayerProperties & player) const;
+	BWAPI::UpgradeType			GetRangeUpgrade() const;
 
 	static const WeaponProperties &	Get(BWAPI::WeaponType type);
 	static void					Init();
@@ -0,0 +1,174 @@
+#ifndef WIN32
+#define APIENTRY
+#define APIENTRYP
+#endif
+
+#include "../SparCraft.h"
+#include "../Timer.h"
+
+using namespace SparCraft;
+
+// times the simulation hot paths on fixed reference states
+// output is one CSV row per benchmark and state so runs can be diffed or plotted:
+//
+//   engine,benchmark,state,ops,ms,ns_per_op
+//
+// usage: SparCraftBenchmark [MinMSPerBenchmark]
+
+namespace
+{
+    // results are folded into this so the compiler can't drop the work being timed
+    size_t sink(0);
+
+    // runs f in doubling batches until at least minMS has passed, then prints the average time per call
+    template <class F>
+    void runBenchmark(const std::string & name, const std::string & stateName, const double & minMS, F & f)
+    {
+        size_t iterations(0);
+        size_t batch(1);
+
+        Timer t;
+        t.start();
+
+        while (true)
+        {
+            for (size_t i(0); i < batch; ++i)
+            {
+                f();
+            }
+
+            iterations += batch;
+
+            if (t.getElapsedTimeInMilliSec() >= minMS)
+            {
+                break;
+            }
+
+            batch *= 2;
+        }
+
+        const double ms(t.getElapsedTimeInMilliSec());
+        printf("SparCraft,%s,%s,%lu,%.3lf,%.1lf\n", name.c_str(), stateName.c_str(), (unsigned long)iterations, ms, 1000000.0 * ms / iterations);
+        fflush(stdout);
+    }
+
+    // two facing blocks of alternating dragoons and zealots, the same formation as the PlayoutBenchmark experiment
+    GameState getFormationState(const size_t & numUnits)
+    {
+        const size_t unitsPerColumn(16);
+        const PositionType spacing(32);
+
+        GameState state;
+
+        for (size_t u(0); u < numUnits; ++u)
+        {
+            const BWAPI::UnitType type((u % 2) ? BWAPI::UnitTypes::Protoss_Zealot : BWAPI::UnitTypes::Protoss_Dragoon);
+            const PositionType column(u / unitsPerColumn);
+            const PositionType y(100 + (u % unitsPerColumn) * spacing);
+
+            state.addUnit(type, Players::Player_One, Position(560 - column * spacing, y));
+            state.addUnit(type, Players::Player_Two, Position(720 + column * spacing, y));
+        }
+
+        state.finishedMoving();
+        return state;
+    }
+
+    // a formation state after a few NOKDPS rounds, so the armies are in range of each other
+    GameState getEngagedState(const size_t & numUnits)
+    {
+        PlayerPtr p1(new Player_NOKDPS(Players::Player_One));
+        PlayerPtr p2(new Player_NOKDPS(Players::Player_Two));
+
+        Game game(getFormationState(numUnits), p1, p2, 20);
+        game.play();
+
+        return game.getState();
+    }
+
+    void runStateBenchmarks(const std::string & stateName, const GameState & state, const double & minMS)
+    {
+        const IDType player(state.whoCanMove() == Players::Player_Two ? Players::Player_Two : Players::Player_One);
+
+        auto copy = [&]()
+        {
+            GameState copy(state);
+            sink += copy.numUnits(player);
+        };
+        runBenchmark("copy", stateName, minMS, copy);
+
+        MoveArray moves;
+        auto generateMoves = [&]()
+        {
+            state.generateMoves(moves, player);
+            sink += moves.numUnits();
+        };
+        runBenchmark("generateMoves", stateName, minMS, generateMoves);
+
+        // the moves a NOKDPS player would make from this state, applied to a fresh copy every time
+        std::vector<Action> moveVec;
+        {
+            GameState scratch(state);
+            Player_NOKDPS nokdps(player);
+            state.generateMoves(moves, player);
+            nokdps.getMoves(scratch, moves, moveVec);
+        }
+
+        auto makeMoves = [&]()
+        {
+            GameState child(state);
+            child.makeMoves(moveVec);
+            child.finishedMoving();
+            sink += child.getTime();
+        };
+        runBenchmark("makeMoves(includes copy)", stateName, minMS, makeMoves);
+
+        // calculateHash is incremental and cached, so the full recalculation is what's timed
+        auto calculateHash = [&]()
+        {
+            sink += state.calculateFullHash(0);
+        };
+        runBenchmark("calculateFullHash", stateName, minMS, calculateHash);
+
+        PlayerPtr p1(new Player_NOKDPS(Players::Player_One));
+        PlayerPtr p2(new Player_NOKDPS(Players::Player_Two));
+        auto playout = [&]()
+        {
+            Game game(state, p1, p2, 0);
+            game.play();
+            sink += game.getRounds();
+        };
+        runBenchmark("playoutNOKDPS", stateName, minMS, playout);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    SparCraft::init();
+
+    try
+    {
+        const double minMS(argc > 1 ? atof(argv[1]) : 1000);
+
+        printf("engine,benchmark,state,ops,ms,ns_per_op\n");
+
+        runStateBenchmarks("formation8", getFormationState(8), minMS);
+        runStateBenchmarks("formation32", getFormationState(32), minMS);
+        runStateBenchmarks("engaged32", getEngagedState(32), minMS);
+
+        fprintf(stderr, "checksum %lu\n", (unsigned long)sink);
+    }
+    catch(int e)
+    {
+        if (e == SparCraft::System::SPARCRAFT_FATAL_ERROR)
+        {
+            std::cerr << "\nSparCraft FatalError Exception, Shutting Down\n\n";
+        }
+        else
+        {
+            std::cerr << "\nUnknown Exception, Shutting Down\n\n";
+        }
+    }
+
+    return 0;
+}
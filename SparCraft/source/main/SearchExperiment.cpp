@@ -6,7 +6,9 @@ SearchExperiment::SearchExperiment(const std::string & configFile)
     : map(NULL)
     , showDisplay(false)
     , appendTimeStamp(true)
-	, rand(0, std::numeric_limits<int>::max(), 0)
+    , seed(0)
+	, rand(0)
+    , numJobs(1)
 {
     configFileSmall = getBaseFilename(configFile);
     map = new Map(40, 22);
@@ -24,6 +26,11 @@ SearchExperiment::~SearchExperiment()
     }
 }
 
+void SearchExperiment::setNumJobs(const size_t & jobs)
+{
+    numJobs = jobs;
+}
+
 void SearchExperiment::setupResults()
 {
     size_t np1 = players[0].size();
@@ -236,6 +243,31 @@ void SearchExperiment::parseConfigFile(const std::string & filename)
 
             appendTimeStamp = strcmp(append.c_str(), "true") == 0 ? true : false;
         }
+        else if (strcmp(option.c_str(), "ThreadScaling") == 0)
+        {
+            size_t numThreads(0);
+            while (iss >> numThreads)
+            {
+                threadScaling.push_back(numThreads);
+            }
+        }
+        else if (strcmp(option.c_str(), "PlayoutBenchmark") == 0)
+        {
+            size_t numUnits(0);
+            while (iss >> numUnits)
+            {
+                playoutBenchmark.push_back(numUnits);
+            }
+        }
+        else if (strcmp(option.c_str(), "Seed") == 0)
+        {
+            iss >> seed;
+            rand.seed(seed);
+        }
+        else if (strcmp(option.c_str(), "SaveStates") == 0)
+        {
+            iss >> saveStatesFile;
+        }
         else if (strcmp(option.c_str(), "PlayerUpgrade") == 0)
         {
             int playerID(0);
@@ -277,6 +309,14 @@ void SearchExperiment::parseConfigFile(const std::string & filename)
             System::FatalError("Invalid Option in Configuration File: " + option);
         }
     }
+
+    for (size_t p(0); p < Constants::Num_Players; ++p)
+    {
+        for (size_t i(0); i < playerLines[p].size(); ++i)
+        {
+            players[p].push_back(createPlayer(playerLines[p][i]));
+        }
+    }
 }
 
 void SearchExperiment::addState(const std::string & line)
@@ -327,6 +367,21 @@ void SearchExperiment::addState(const std::string & line)
             states.push_back(GameState(filename));
         }
     }
+    else if (strcmp(stateType.c_str(), "StateSnapshotFile") == 0)
+    {
+        std::string filename;
+        iss >> filename;
+
+        // numStates of 0 loads every state in the file
+        GameStateFile file(filename);
+        const size_t numToLoad(numStates > 0 ? std::min((size_t)numStates, file.numStates()) : file.numStates());
+
+        states.reserve(states.size() + numToLoad);
+        for (size_t i(0); i<numToLoad; ++i)
+        {
+            states.push_back(file.getState(i));
+        }
+    }
     else if (strcmp(stateType.c_str(), "StateDescriptionFile") == 0)
     {
         std::string filename;
@@ -427,6 +482,23 @@ void SearchExperiment::addPlayer(const std::string & line)
 {
     std::istringstream iss(line);
 
+    std::string player;
+    int playerID;
+    std::string playerModelString;
+    
+    iss >> player;
+    iss >> playerID;
+    iss >> playerModelString;
+
+    playerStrings[playerID].push_back(playerModelString);
+    playerLines[playerID].push_back(line);
+}
+
+// constructs a new player from its line in the configuration file
+PlayerPtr SearchExperiment::createPlayer(const std::string & line)
+{
+    std::istringstream iss(line);
+
     // Regular expressions for line validation (if I ever want to use them)
     //std::regex ScriptRegex("[a-zA-Z]+[ ]+[0-1][ ]+[a-zA-Z]+[ ]*");
     //std::regex AlphaBetaRegex("[a-zA-Z]+[ ]+[0-1][ ]+[a-zA-Z]+[ ]+[0-9]+[ ]+[0-9]+[ ]+[a-zA-Z]+[ ]+[a-zA-Z]+[ ]+[a-zA-Z]+[ ]+[a-zA-Z]+[ ]+[a-zA-Z]+[ ]+[a-zA-Z]+[ ]*");
@@ -444,47 +516,45 @@ void SearchExperiment::addPlayer(const std::string & line)
     iss >> playerID;
     iss >> playerModelString;
 
-    playerStrings[playerID].push_back(playerModelString);
-
     playerModelID = PlayerModels::getID(playerModelString);
 
     //std::cout << "Player " << playerID << " adding type " << playerModelString << " (" << playerModelID << ")" << std::endl;
 
    	if (playerModelID == PlayerModels::AttackClosest)		
     { 
-        players[playerID].push_back(PlayerPtr(new Player_AttackClosest(playerID))); 
+        return PlayerPtr(new Player_AttackClosest(playerID));
     }
 	else if (playerModelID == PlayerModels::AttackDPS)
     { 
-        players[playerID].push_back(PlayerPtr(new Player_AttackDPS(playerID))); 
+        return PlayerPtr(new Player_AttackDPS(playerID));
     }
 	else if (playerModelID == PlayerModels::AttackWeakest)		
     { 
-        players[playerID].push_back(PlayerPtr(new Player_AttackWeakest(playerID))); 
+        return PlayerPtr(new Player_AttackWeakest(playerID));
     }
 	else if (playerModelID == PlayerModels::Kiter)				
     { 
-        players[playerID].push_back(PlayerPtr(new Player_Kiter(playerID))); 
+        return PlayerPtr(new Player_Kiter(playerID));
     }
 	else if (playerModelID == PlayerModels::KiterDPS)			
     { 
-        players[playerID].push_back(PlayerPtr(new Player_KiterDPS(playerID))); 
+        return PlayerPtr(new Player_KiterDPS(playerID));
     }
     else if (playerModelID == PlayerModels::Kiter_NOKDPS)			
     { 
-        players[playerID].push_back(PlayerPtr(new Player_Kiter_NOKDPS(playerID))); 
+        return PlayerPtr(new Player_Kiter_NOKDPS(playerID));
     }
     else if (playerModelID == PlayerModels::Cluster)			
     { 
-        players[playerID].push_back(PlayerPtr(new Player_Cluster(playerID))); 
+        return PlayerPtr(new Player_Cluster(playerID));
     }
 	else if (playerModelID == PlayerModels::NOKDPS)	
     { 
-        players[playerID].push_back(PlayerPtr(new Player_NOKDPS(playerID))); 
+        return PlayerPtr(new Player_NOKDPS(playerID));
     }
 	else if (playerModelID == PlayerModels::Random)				
     { 
-        players[playerID].push_back(PlayerPtr(new Player_Random(playerID))); 
+        return PlayerPtr(new Player_Random(playerID));
     }
     else if (playerModelID == PlayerModels::PortfolioGreedySearch)				
     { 
@@ -492,13 +562,17 @@ void SearchExperiment::addPlayer(const std::string & line)
         size_t timeLimit(0);
         int iterations(1);
         int responses(0);
+        size_t numThreads(1);
 
         iss >> timeLimit;
         iss >> enemyPlayerModel;
         iss >> iterations;
         iss >> responses;
 
-        players[playerID].push_back(PlayerPtr(new Player_PortfolioGreedySearch(playerID, PlayerModels::getID(enemyPlayerModel), iterations, responses, timeLimit))); 
+        // optional number of threads to evaluate each unit's scripts on
+        iss >> numThreads;
+
+        return PlayerPtr(new Player_PortfolioGreedySearch(playerID, PlayerModels::getID(enemyPlayerModel), iterations, responses, timeLimit, numThreads));
     }
     else if (playerModelID == PlayerModels::AlphaBeta)
     {
@@ -510,6 +584,8 @@ void SearchExperiment::addPlayer(const std::string & line)
         std::string     playoutScript2;
         std::string     playerToMoveMethod;
         std::string     opponentModelScript;
+        int             numThreads(1);
+        int             ttSizeMB(Constants::Transposition_Table_Size_MB);
 
         // read in the values
         iss >> timeLimitMS;
@@ -521,6 +597,10 @@ void SearchExperiment::addPlayer(const std::string & line)
         iss >> playerToMoveMethod;
         iss >> opponentModelScript;
 
+        // optional number of Lazy SMP threads and transposition table size
+        iss >> numThreads;
+        iss >> ttSizeMB;
+
         // convert them to the proper enum types
         int moveOrderingID      = MoveOrderMethod::getID(moveOrdering);
         int evalMethodID        = EvaluationMethods::getID(evalMethod);
@@ -544,9 +624,11 @@ void SearchExperiment::addPlayer(const std::string & line)
         params.setEvalMethod(evalMethodID);
         params.setSimScripts(playoutScriptID1, playoutScriptID2);
         params.setPlayerToMoveMethod(playerToMoveID);
+        params.setNumThreads(numThreads);
+        params.setTTSizeMB(ttSizeMB);
 	
         // add scripts for move ordering
-        if (moveOrderingID == MoveOrderMethod::ScriptFirst)
+        if ((moveOrderingID == MoveOrderMethod::ScriptFirst) || (moveOrderingID == MoveOrderMethod::ScriptFirstHistory))
         {
             params.addOrderedMoveScript(PlayerModels::NOKDPS);
             params.addOrderedMoveScript(PlayerModels::KiterDPS);
@@ -569,8 +651,7 @@ void SearchExperiment::addPlayer(const std::string & line)
             }
         }
 
-        PlayerPtr abPlayer(new Player_AlphaBeta(playerID, params, TTPtr((TranspositionTable *)NULL)));
-        players[playerID].push_back(abPlayer); 
+        return PlayerPtr(new Player_AlphaBeta(playerID, params, TTPtr((TranspositionTable *)NULL)));
     }
     else if (playerModelID == PlayerModels::UCT)
     {
@@ -584,6 +665,8 @@ void SearchExperiment::addPlayer(const std::string & line)
         std::string     playoutScript2;
         std::string     playerToMoveMethod;
         std::string     opponentModelScript;
+        int             numThreads(1);
+        std::string     parallelMethod("Tree");
 
         // read in the values
         iss >> timeLimitMS;
@@ -597,6 +680,12 @@ void SearchExperiment::addPlayer(const std::string & line)
         iss >> playerToMoveMethod;
         iss >> opponentModelScript;
 
+        // optional thread count and parallel method
+        if (iss >> numThreads)
+        {
+            iss >> parallelMethod;
+        }
+
         // convert them to the proper enum types
         int moveOrderingID      = MoveOrderMethod::getID(moveOrdering);
         int evalMethodID        = EvaluationMethods::getID(evalMethod);
@@ -618,6 +707,8 @@ void SearchExperiment::addPlayer(const std::string & line)
         params.setEvalMethod(evalMethodID);
         params.setSimScripts(playoutScriptID1, playoutScriptID2);
         params.setPlayerToMoveMethod(playerToMoveID);
+        params.setNumThreads(numThreads);
+        params.setParallelMethod(UCTParallelMethods::getID(parallelMethod));
         //params.setGraphVizFilename("__uct.txt");
 
         // add scripts for move ordering
@@ -643,19 +734,20 @@ void SearchExperiment::addPlayer(const std::string & line)
             }
         }
 
-        PlayerPtr uctPlayer(new Player_UCT(playerID, params));
-        players[playerID].push_back(uctPlayer); 
+        return PlayerPtr(new Player_UCT(playerID, params));
     }
 	else
     {
         System::FatalError("Invalid Player Type in Configuration File: " + playerModelString);
     }
+
+    return PlayerPtr();
 }
 
 Position SearchExperiment::getRandomPosition(const PositionType & xlimit, const PositionType & ylimit)
 {
-	int x = xlimit - (rand.nextInt() % (2*xlimit));
-	int y = ylimit - (rand.nextInt() % (2*ylimit));
+	int x = xlimit - rand.nextInt(2*xlimit);
+	int y = ylimit - rand.nextInt(2*ylimit);
 
 	return Position(x, y);
 }
@@ -685,7 +777,7 @@ GameState SearchExperiment::getSymmetricState( std::vector<std::string> & unitTy
         // add the symmetric unit for each count in the numUnits Vector
         for (int u(0); u<numUnits[i]; ++u)
 	    {
-            Position r((rand.nextInt() % (2*xLimit)) - xLimit, (rand.nextInt() % (2*yLimit)) - yLimit);
+            Position r(rand.nextInt(2*xLimit) - xLimit, rand.nextInt(2*yLimit) - yLimit);
             Position u1(mid.x() + r.x(), mid.y() + r.y());
             Position u2(mid.x() - r.x(), mid.y() - r.y());
 
@@ -723,7 +815,7 @@ void SearchExperiment::addSeparatedState(  std::vector<std::string> & unitTypes,
         // add the symmetric unit for each count in the numUnits Vector
         for (int u(0); u<numUnits[i]; ++u)
 	    {
-            Position r((rand.nextInt() % (2*xLimit)) - xLimit, (rand.nextInt() % (2*yLimit)) - yLimit);
+            Position r(rand.nextInt(2*xLimit) - xLimit, rand.nextInt(2*yLimit) - yLimit);
             Position u1(cx1 + r.x(), cy1 + r.y());
             Position u2(cx2 - r.x(), cy2 - r.y());
 
@@ -823,20 +915,215 @@ std::string SearchExperiment::getBaseFilename(const std::string & filename)
     return filename;
 }
 
-void SearchExperiment::runExperiment()
+// searches every state once with each AlphaBeta player at each of the ThreadScaling thread counts
+// and reports the nodes per second of all threads, speedup is relative to the first thread count
+void SearchExperiment::runThreadScaling()
 {
     std::ofstream results(getResultsOutFileName().c_str());
     if (!results.is_open())
     {
         System::FatalError("Problem Opening Output File: Results Raw");
     }
-    
+
+    char buf[255];
+    sprintf(buf, "%5s %5s %5s %5s %8s %14s %12s %14s %8s\n", "P", "PI", "ST", "UNIT", "THREADS", "NODES", "MS", "NODES/SEC", "SPEEDUP");
+    fprintf(stderr, "%s", buf);
+    results << buf;
+
+    for (size_t p(0); p < Constants::Num_Players; ++p)
+    {
+        for (size_t pi(0); pi < players[p].size(); ++pi)
+        {
+            Player_AlphaBeta * abPlayer = dynamic_cast<Player_AlphaBeta *>(players[p][pi].get());
+            if (!abPlayer)
+            {
+                continue;
+            }
+
+            for (size_t state(0); state < states.size(); ++state)
+            {
+                double baseNodesPerSec(0);
+
+                for (size_t t(0); t < threadScaling.size(); ++t)
+                {
+                    // each search gets its own copy of the state and a fresh transposition table
+                    AlphaBetaSearchParameters params(abPlayer->getParams());
+                    params.setNumThreads(threadScaling[t]);
+
+                    AlphaBetaSearch search(params, TTPtr(new TranspositionTable(params.ttSizeMB())));
+                    GameState searchState(states[state]);
+                    search.doSearch(searchState);
+
+                    const unsigned long long nodes = search.getResults().totalNodesExpanded;
+                    const double ms = search.getResults().timeElapsed;
+                    const double nodesPerSec = ms > 0 ? (1000.0 * nodes / ms) : 0;
+
+                    if (t == 0)
+                    {
+                        baseNodesPerSec = nodesPerSec;
+                    }
+
+                    sprintf(buf, "%5d %5d %5d %5d %8d %14llu %12.2lf %14.2lf %8.2lf\n", (int)p, (int)pi, (int)state, (int)states[state].numUnits(Players::Player_One), 
+                        (int)threadScaling[t], nodes, ms, nodesPerSec, baseNodesPerSec > 0 ? (nodesPerSec / baseNodesPerSec) : 0);
+                    fprintf(stderr, "%s", buf);
+                    results << buf;
+                }
+            }
+        }
+    }
+
+    results.close();
+}
+
+// a fixed dragoon / zealot formation for each player so that benchmark states don't depend on the random seed
+GameState SearchExperiment::getPlayoutBenchmarkState(const size_t & numUnits)
+{
+    const size_t unitsPerColumn(16);
+    const PositionType spacing(32);
+
+    GameState state;
+
+    for (size_t u(0); u < numUnits; ++u)
+    {
+        const BWAPI::UnitType type((u % 2) ? BWAPI::UnitTypes::Protoss_Zealot : BWAPI::UnitTypes::Protoss_Dragoon);
+        const PositionType column(u / unitsPerColumn);
+        const PositionType y(100 + (u % unitsPerColumn) * spacing);
+
+        state.addUnit(type, Players::Player_One, Position(560 - column * spacing, y));
+        state.addUnit(type, Players::Player_Two, Position(720 + column * spacing, y));
+    }
+
+    state.setMap(map);
+    state.finishedMoving();
+    return state;
+}
+
+// plays script playouts the way PortfolioGreedySearch does, with units alternating between NOKDPS and KiterDPS,
+// for about a second on each of the PlayoutBenchmark state sizes and reports playouts per second
+// also times copying the state and generating its moves, which search does for every node
+void SearchExperiment::runPlayoutBenchmark()
+{
+    std::ofstream results(getResultsOutFileName().c_str());
+    if (!results.is_open())
+    {
+        System::FatalError("Problem Opening Output File: Results Raw");
+    }
+
+    char buf[255];
+    sprintf(buf, "%5s %10s %12s %14s %14s %14s %14s\n", "UNIT", "PLAYOUTS", "MS", "PLAYOUTS/SEC", "ROUNDS/SEC", "COPIES/SEC", "GENMOVES/SEC");
+    fprintf(stderr, "%s", buf);
+    results << buf;
+
+    const double benchmarkMS(1000);
+
+    for (size_t b(0); b < playoutBenchmark.size(); ++b)
+    {
+        const GameState state(getPlayoutBenchmarkState(playoutBenchmark[b]));
+
+        UnitScriptData scriptData;
+        for (IDType p(0); p < Constants::Num_Players; ++p)
+        {
+            for (IDType u(0); u < state.numUnits(p); ++u)
+            {
+                scriptData.setUnitScript(state.getUnit(p, u), (u % 2) ? PlayerModels::KiterDPS : PlayerModels::NOKDPS);
+            }
+        }
+
+        // the same Game is reset for every playout, as each search thread does
+        Game game(state, 100);
+        unsigned long long playouts(0);
+        unsigned long long rounds(0);
+
+        Timer t;
+        t.start();
+
+        while (playouts == 0 || t.getElapsedTimeInMilliSec() < benchmarkMS)
+        {
+            game.reset(state);
+            game.playIndividualScripts(scriptData);
+
+            playouts++;
+            rounds += game.getRounds();
+        }
+
+        const double ms = t.getElapsedTimeInMilliSec();
+
+        // the timer is only checked every batch so that it doesn't dominate these much shorter operations
+        const size_t batch(100);
+        unsigned long long copies(0);
+        size_t unitsCopied(0);
+
+        t.start();
+        while (t.getElapsedTimeInMilliSec() < benchmarkMS / 4)
+        {
+            for (size_t i(0); i < batch; ++i)
+            {
+                GameState copy(state);
+                unitsCopied += copy.numUnits(Players::Player_One);
+            }
+
+            copies += batch;
+        }
+        const double copyMS = t.getElapsedTimeInMilliSec();
+
+        MoveArray moves;
+        unsigned long long generates(0);
+
+        t.start();
+        while (t.getElapsedTimeInMilliSec() < benchmarkMS / 4)
+        {
+            for (size_t i(0); i < batch; ++i)
+            {
+                state.generateMoves(moves, state.whoCanMove() == Players::Player_Two ? Players::Player_Two : Players::Player_One);
+            }
+
+            generates += batch;
+        }
+        const double generateMS = t.getElapsedTimeInMilliSec();
+
+        SPARCRAFT_ASSERT(unitsCopied == copies * state.numUnits(Players::Player_One), "State copies lost units");
+
+        sprintf(buf, "%5d %10llu %12.2lf %14.2lf %14.2lf %14.2lf %14.2lf\n", (int)playoutBenchmark[b], playouts, ms, 1000.0 * playouts / ms, 1000.0 * rounds / ms,
+            1000.0 * copies / copyMS, 1000.0 * generates / generateMS);
+        fprintf(stderr, "%s", buf);
+        results << buf;
+    }
+
+    results.close();
+}
+
+void SearchExperiment::runExperiment()
+{
     // set the map file for all states
     for (size_t state(0); state < states.size(); ++state)
 	{
         states[state].setMap(map);
     }
 
+    if (!saveStatesFile.empty())
+    {
+        GameStateFile::Write(saveStatesFile, states);
+        return;
+    }
+
+    if (!threadScaling.empty())
+    {
+        runThreadScaling();
+        return;
+    }
+
+    if (!playoutBenchmark.empty())
+    {
+        runPlayoutBenchmark();
+        return;
+    }
+
+    std::ofstream results(getResultsOutFileName().c_str());
+    if (!results.is_open())
+    {
+        System::FatalError("Problem Opening Output File: Results Raw");
+    }
+
 	#ifdef USING_VISUALIZATION_LIBRARIES
 		GUI * disp = NULL;
         if (showDisplay)
@@ -849,102 +1136,177 @@ void SearchExperiment::runExperiment()
 	#endif
 
 	results << "   P1    P2    ST  UNIT       EVAL    RND           MS | UnitType PlayerID CurrentHP XPos YPos\n";
-    
-	// for each player one player
+
+    // every combination of player one, player two and state we care about, in the order results are written
+    std::vector<GameJob> jobs;
 	for (size_t p1Player(0); p1Player < players[0].size(); p1Player++)
 	{
-		// for each player two player
 		for (size_t p2Player(0); p2Player < players[1].size(); p2Player++)
 		{
-			// for each state we care about
 			for (size_t state(2); state < states.size(); ++state)
 			{
-                char buf[255];
-                fprintf(stderr, "%s  ", configFileSmall.c_str());
-				fprintf(stderr, "%5d %5d %5d %5d", (int)p1Player, (int)p2Player, (int)state, (int)states[state].numUnits(Players::Player_One));
-				sprintf(buf, "%5d %5d %5d %5d", (int)p1Player, (int)p2Player, (int)state, (int)states[state].numUnits(Players::Player_One));
-                results << buf;
-
-				resultsPlayers[0].push_back(p1Player);
-				resultsPlayers[1].push_back(p2Player);
-				resultsStateNumber[p1Player][p2Player].push_back(state);
-				resultsNumUnits[p1Player][p2Player].push_back(states[state].numUnits(Players::Player_One));
-				
-				// get player one
-				PlayerPtr playerOne(players[0][p1Player]);
-
-				// give it a new transposition table if it's an alpha beta player
-				Player_AlphaBeta * p1AB = dynamic_cast<Player_AlphaBeta *>(playerOne.get());
-				if (p1AB)
-				{
-					p1AB->setTranspositionTable(TTPtr(new TranspositionTable()));
-				}
-
-				// get player two
-				PlayerPtr playerTwo(players[1][p2Player]);
-				Player_AlphaBeta * p2AB = dynamic_cast<Player_AlphaBeta *>(playerTwo.get());
-				if (p2AB)
-				{
-					p2AB->setTranspositionTable(TTPtr(new TranspositionTable()));
-				}
-
-				// construct the game
-				Game g(states[state], playerOne, playerTwo, 20000);
-                ScoreType gameEval = 0;
-
-                if (showDisplay)
-                {
-					static GUI gui(1280, 720);
-                    gui.setGame(g);
+                GameJob job = { p1Player, p2Player, state };
+                jobs.push_back(job);
+            }
+        }
+    }
 
-                    while (!gui.getGame().gameOver())
-                    {
-                        gui.onFrame();
-                    }
+    // the display can only be drawn from this thread
+    size_t workers = std::max(std::min(numJobs, jobs.size()), (size_t)1);
+    if (showDisplay && (workers > 1))
+    {
+        fprintf(stderr, "Display is on, playing games on a single thread\n");
+        workers = 1;
+    }
 
-                    gameEval = gui.getGame().getState().eval(Players::Player_One, SparCraft::EvaluationMethods::LTD2).val();
-                }
-                else
-                {
-                    gameEval = g.getState().eval(Players::Player_One, SparCraft::EvaluationMethods::LTD2).val();
-                }
+    WorkStealingQueue queue(jobs.size(), workers);
+    std::vector<GameResult> gameResults(jobs.size());
+    std::vector<char> finished(jobs.size(), 0);
+    size_t nextToWrite(0);
+    std::mutex resultsMutex;
+    std::exception_ptr error;
 
-                numGames[p1Player][p2Player]++;
-                if (gameEval > 0)
-                {
-                    numWins[p1Player][p2Player]++;
-                }
-                else if (gameEval < 0)
-                {
-                    numLosses[p1Player][p2Player]++;
-                }
-                else if (gameEval == 0)
+    // games finish in any order, but results are written in job order as soon as all earlier games are done
+    auto worker = [&](const size_t w)
+    {
+        try
+        {
+            size_t j(0);
+            while (queue.pop(w, j))
+            {
+                playGame(j, jobs[j], gameResults[j]);
+
+                std::lock_guard<std::mutex> lock(resultsMutex);
+                finished[j] = 1;
+
+                while ((nextToWrite < jobs.size()) && finished[nextToWrite])
                 {
-                    numDraws[p1Player][p2Player]++;
+                    recordGameResult(results, jobs[nextToWrite], gameResults[nextToWrite]);
+                    nextToWrite++;
                 }
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(resultsMutex);
+            error = std::current_exception();
+        }
+    };
 
-				double ms = g.getTime();
-				sprintf(buf, " %10d %6d %12.2lf", gameEval, g.getRounds(), ms);
-				fprintf(stderr, "%12d %12.2lf\n", gameEval, ms);
+    if (workers == 1)
+    {
+        worker(0);
+    }
+    else
+    {
+        std::vector<std::thread> threads;
+        for (size_t w(0); w < workers; ++w)
+        {
+            threads.push_back(std::thread(worker, w));
+        }
 
-				resultsEval[p1Player][p2Player].push_back(gameEval);
-				resultsRounds[p1Player][p2Player].push_back(g.getRounds());
-				resultsTime[p1Player][p2Player].push_back(ms);
+        for (size_t w(0); w < workers; ++w)
+        {
+            threads[w].join();
+        }
+    }
 
-                results << buf;
-                printStateUnits(results, g.getState());
-                results << std::endl;
-                
-                writeResultsSummary();
-			}
-		}
-	}
-    
     results.close();
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+// each game's seed depends only on the experiment seed and the game's number, so a game plays out the same way whichever worker runs it
+unsigned long long SearchExperiment::getGameSeed(const size_t & game) const
+{
+    return Random::Get(seed, game);
+}
+
+// plays a single game with newly constructed players, so no search state is shared between games
+void SearchExperiment::playGame(const size_t & game, const GameJob & job, GameResult & result)
+{
+    PlayerPtr playerOne(createPlayer(playerLines[0][job.p1Player]));
+    PlayerPtr playerTwo(createPlayer(playerLines[1][job.p2Player]));
+
+	// construct the game
+	Game g(states[job.state], playerOne, playerTwo, 20000);
+    g.setSeed(getGameSeed(game));
+
+    if (showDisplay)
+    {
+		static GUI gui(1280, 720);
+        gui.setGame(g);
+
+        while (!gui.getGame().gameOver())
+        {
+            gui.onFrame();
+        }
+
+        g = gui.getGame();
+    }
+    else
+    {
+        g.play();
+    }
+
+    result.eval     = g.getState().eval(Players::Player_One, SparCraft::EvaluationMethods::LTD2).val();
+    result.rounds   = g.getRounds();
+    result.ms       = g.getTime();
+
+    std::stringstream units;
+    printStateUnits(units, g.getState());
+    result.units = units.str();
 }
 
+void SearchExperiment::recordGameResult(std::ofstream & results, const GameJob & job, const GameResult & result)
+{
+    const size_t p1Player(job.p1Player);
+    const size_t p2Player(job.p2Player);
+    const size_t state(job.state);
+
+    char buf[255];
+    fprintf(stderr, "%s  ", configFileSmall.c_str());
+	fprintf(stderr, "%5d %5d %5d %5d", (int)p1Player, (int)p2Player, (int)state, (int)states[state].numUnits(Players::Player_One));
+	sprintf(buf, "%5d %5d %5d %5d", (int)p1Player, (int)p2Player, (int)state, (int)states[state].numUnits(Players::Player_One));
+    results << buf;
+
+	resultsPlayers[0].push_back(p1Player);
+	resultsPlayers[1].push_back(p2Player);
+	resultsStateNumber[p1Player][p2Player].push_back(state);
+	resultsNumUnits[p1Player][p2Player].push_back(states[state].numUnits(Players::Player_One));
+
+    numGames[p1Player][p2Player]++;
+    if (result.eval > 0)
+    {
+        numWins[p1Player][p2Player]++;
+    }
+    else if (result.eval < 0)
+    {
+        numLosses[p1Player][p2Player]++;
+    }
+    else if (result.eval == 0)
+    {
+        numDraws[p1Player][p2Player]++;
+    }
+
+	sprintf(buf, " %10d %6d %12.2lf", result.eval, result.rounds, result.ms);
+	fprintf(stderr, "%12d %12.2lf\n", result.eval, result.ms);
+
+	resultsEval[p1Player][p2Player].push_back(result.eval);
+	resultsRounds[p1Player][p2Player].push_back(result.rounds);
+	resultsTime[p1Player][p2Player].push_back(result.ms);
+
+    results << buf;
+    results << result.units;
+    results << std::endl;
+                
+    writeResultsSummary();
+}
 
-void SearchExperiment::printStateUnits(std::ofstream & results, GameState & state)
+void SearchExperiment::printStateUnits(std::ostream & results, GameState & state)
 {
     std::stringstream ss;
     for (size_t p(0); p<Constants::Num_Players; ++p)
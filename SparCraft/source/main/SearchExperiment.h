@@ -2,7 +2,11 @@
 
 #include "../SparCraft.h"
 #include "../gui/GUI.h"
+#include "WorkStealingQueue.hpp"
 #include <iomanip>
+#include <thread>
+#include <mutex>
+#include <exception>
 
 namespace SparCraft
 {
@@ -24,8 +28,25 @@ namespace SparCraft
 {
 class SearchExperiment
 {
+    // one game of the experiment and its outcome
+    struct GameJob
+    {
+        size_t                  p1Player;
+        size_t                  p2Player;
+        size_t                  state;
+    };
+
+    struct GameResult
+    {
+        ScoreType               eval;
+        int                     rounds;
+        double                  ms;
+        std::string             units;
+    };
+
 	std::vector<PlayerPtr>      players[2];
     std::vector<std::string>    playerStrings[2];
+    std::vector<std::string>    playerLines[2];     // config lines the players were made from, every game constructs its own
     std::vector<GameState>      states;
     Map *                       map;
     bool                        showDisplay;
@@ -48,10 +69,17 @@ class SearchExperiment
     ivv                         numLosses;
 	ivv                         numDraws;
 
-	RandomInt					rand;
+    unsigned long long          seed;               // experiment seed, every state and game is generated from it
+    Random                      rand;               // generates the random states, seeded with the experiment seed
+
+    std::vector<size_t>         threadScaling;      // thread counts to benchmark AlphaBeta players with, empty to play games
+    size_t                      numJobs;            // number of games played at once
+    std::vector<size_t>         playoutBenchmark;   // units per side of the states to time script playouts on, empty to play games
+    std::string                 saveStatesFile;     // state file to write every state to, empty to play games
 
     void setupResults();
     void addPlayer(const std::string & line);
+    PlayerPtr createPlayer(const std::string & line);
     void addState(const std::string & line);
     void padString(std::string & str, const size_t & length);
     void setCurrentDateTime();
@@ -84,14 +112,21 @@ class SearchExperiment
     std::string getResultsOutFileName();
     std::string getConfigOutFileName();
     std::string currentDateTime();
-    void printStateUnits(std::ofstream & results, GameState & state);
+    void printStateUnits(std::ostream & results, GameState & state);
     void addGameState(const GameState & state);
+    void runThreadScaling();
+    GameState getPlayoutBenchmarkState(const size_t & numUnits);
+    void runPlayoutBenchmark();
+    unsigned long long getGameSeed(const size_t & game) const;
+    void playGame(const size_t & game, const GameJob & job, GameResult & result);
+    void recordGameResult(std::ofstream & results, const GameJob & job, const GameResult & result);
 
 public:
 
     SearchExperiment(const std::string & configFile);
     ~SearchExperiment();
 
+    void setNumJobs(const size_t & jobs);
     void runExperiment();
 	void writeResultsSummary();
 };
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <memory>
+
+namespace SparCraft
+{
+    class WorkStealingQueue;
+}
+
+// hands out job indices to a fixed number of workers
+// jobs are dealt round robin so that lower indices tend to finish first, and a worker
+// which runs out of its own jobs steals from the back of another worker's queue
+class SparCraft::WorkStealingQueue
+{
+    struct WorkerQueue
+    {
+        std::mutex          mutex;
+        std::deque<size_t>  jobs;
+    };
+
+    std::vector< std::unique_ptr<WorkerQueue> > _queues;
+
+public:
+
+    WorkStealingQueue(const size_t & numJobs, const size_t & numWorkers)
+    {
+        for (size_t w(0); w < numWorkers; ++w)
+        {
+            _queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+        }
+
+        for (size_t j(0); j < numJobs; ++j)
+        {
+            _queues[j % numWorkers]->jobs.push_back(j);
+        }
+    }
+
+    // gets the next job for this worker, returns false once every queue is empty
+    bool pop(const size_t & worker, size_t & job)
+    {
+        {
+            WorkerQueue & own = *_queues[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+
+            if (!own.jobs.empty())
+            {
+                job = own.jobs.front();
+                own.jobs.pop_front();
+                return true;
+            }
+        }
+
+        for (size_t i(1); i < _queues.size(); ++i)
+        {
+            WorkerQueue & victim = *_queues[(worker + i) % _queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+
+            if (!victim.jobs.empty())
+            {
+                job = victim.jobs.back();
+                victim.jobs.pop_back();
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
@@ -5,6 +5,9 @@
 
 #include "../SparCraft.h"
 #include "SearchExperiment.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 
 int main(int argc, char *argv[])
 {
@@ -12,14 +15,24 @@ int main(int argc, char *argv[])
 
     try
     {
-        if (argc == 2)
+        // usage: SparCraft [--jobs N] experiment_file
+        size_t numJobs(1);
+        int arg(1);
+        if ((argc == 4) && (strcmp(argv[1], "--jobs") == 0))
         {
-            SparCraft::SearchExperiment exp(argv[1]);
+            numJobs = std::max(atoi(argv[2]), 1);
+            arg = 3;
+        }
+
+        if (argc == arg + 1)
+        {
+            SparCraft::SearchExperiment exp(argv[arg]);
+            exp.setNumJobs(numJobs);
             exp.runExperiment();
         }
         else
         {
-            SparCraft::System::FatalError("Please provide experiment file as only argument");
+            SparCraft::System::FatalError("Please provide experiment file as only argument, optionally preceded by --jobs N");
         }
     }
     catch(int e)
@@ -4,6 +4,9 @@
 
 using namespace UAlbertaBot;
 
+// how long the background search runs between checks for cancellation
+const int BackgroundSearchSliceMS = 10;
+
 // get an instance of this
 BOSSManager & BOSSManager::Instance() 
 {
@@ -23,14 +26,32 @@ BOSSManager::BOSSManager()
 
 void BOSSManager::reset()
 {
+    cancelSearch();
+
     _previousSearchResults = BOSS::DFBB_BuildOrderSearchResults();
     _searchInProgress = false;
     _previousBuildOrder.clear();
 }
 
-// start a new search for a new goal
+// stops the background search if there is one, its results are thrown away
+void BOSSManager::cancelSearch()
+{
+    if (!_backgroundSearch)
+    {
+        return;
+    }
+
+    _backgroundSearch->cancelled = true;
+    _searchThread.join();
+    _backgroundSearch.reset();
+    _searchInProgress = false;
+}
+
+// start a new search for a new goal, any background search must have been cancelled or finished
 void BOSSManager::startNewSearch(const std::vector<MetaPair> & goalUnits)
 {
+    UAB_ASSERT(!_backgroundSearch, "Starting a build order search while a background search is running");
+
     size_t numWorkers   = UnitUtil::GetAllUnitCount(BWAPI::Broodwar->self()->getRace().getWorker());
     size_t numDepots    = UnitUtil::GetAllUnitCount(BWAPI::Broodwar->self()->getRace().getCenter())
                         + UnitUtil::GetAllUnitCount(BWAPI::UnitTypes::Zerg_Lair)
@@ -63,6 +84,13 @@ void BOSSManager::startNewSearch(const std::vector<MetaPair> & goalUnits)
         _previousSearchStartFrame = BWAPI::Broodwar->getFrameCount();
         _totalPreviousSearchTime = 0;
         _previousGoalUnits = goalUnits;
+
+        // the initial state is a snapshot, so the search thread never has to touch BWAPI
+        if (Config::Macro::BOSSSearchInBackground)
+        {
+            _backgroundSearch = BackgroundSearchPtr(new BOSSBackgroundSearch(_smartSearch));
+            _searchThread = std::thread(&BOSSManager::RunBackgroundSearch, _backgroundSearch);
+        }
     }
     catch (const BOSS::BOSSException)
     {
@@ -118,6 +146,13 @@ void BOSSManager::drawStateInformation(int x, int y)
 // tell the search to keep going for however long we have this frame
 void BOSSManager::update(double timeLimit)
 {
+    // a background search doesn't need any of this frame's time, just check whether it's done
+    if (_backgroundSearch)
+    {
+        updateBackgroundSearch();
+        return;
+    }
+
     // if there's a search in progress, resume it
     if (isSearchInProgress())
     {
@@ -150,86 +185,147 @@ void BOSSManager::update(double timeLimit)
         bool previousSearchComplete = searchTimeOut || _smartSearch->getResults().solved || caughtException;
         if (previousSearchComplete)
         {
-            bool solved = _smartSearch->getResults().solved && _smartSearch->getResults().solutionFound;
+            finishSearch(searchTimeOut, caughtException);
+        }
+    }
+}
+
+// runs on the search thread, searching in short slices so that a cancel is noticed quickly
+void BOSSManager::RunBackgroundSearch(BackgroundSearchPtr backgroundSearch)
+{
+    try
+    {
+        backgroundSearch->search->setTimeLimit(BackgroundSearchSliceMS);
+
+        do
+        {
+            backgroundSearch->search->search();
+            backgroundSearch->searchTime += backgroundSearch->search->getResults().timeElapsed;
+        }
+        while (!backgroundSearch->search->getResults().solved && !backgroundSearch->cancelled);
+    }
+    catch (const BOSS::BOSSException & exception)
+    {
+        backgroundSearch->caughtException = true;
+        backgroundSearch->exceptionMessage = exception.what();
+    }
 
-            // if we've found a solution, let us know
-            if (_smartSearch->getResults().solved && Config::Debug::DrawBuildOrderSearchInfo)
-            {
-                //BWAPI::Broodwar->printf("Build order SOLVED in %d nodes", (int)_smartSearch->getResults().nodesExpanded);
-            }
+    // everything above must be visible to the main thread before it sees finished
+    backgroundSearch->finished.store(true, std::memory_order_release);
+}
+
+// polls the background search, and stops it once we've hit the overall frame limit
+void BOSSManager::updateBackgroundSearch()
+{
+    bool searchTimeOut = (BWAPI::Broodwar->getFrameCount() > (_previousSearchStartFrame + Config::Macro::BOSSFrameLimit));
+    if (searchTimeOut)
+    {
+        _backgroundSearch->cancelled = true;
+    }
 
-            if (_smartSearch->getResults().solved)
+    if (!_backgroundSearch->finished.load(std::memory_order_acquire))
+    {
+        _previousStatus = std::string("\x04") + "BOSS Searching\n";
+        return;
+    }
+
+    // the thread has already finished, so this doesn't wait
+    _searchThread.join();
+    _previousStatus.clear();
+    _totalPreviousSearchTime = _backgroundSearch->searchTime;
+
+    bool caughtException = _backgroundSearch->caughtException;
+    if (caughtException)
+    {
+        UAB_ASSERT_WARNING(false, "BOSS SmartSearch Exception: %s", _backgroundSearch->exceptionMessage.c_str());
+        _previousStatus = "BOSSExeption";
+    }
+
+    _backgroundSearch.reset();
+    finishSearch(searchTimeOut, caughtException);
+}
+
+// records the results of a search which has solved, timed out or failed, and readies us for the next one
+void BOSSManager::finishSearch(bool searchTimeOut, bool caughtException)
+{
+    bool solved = _smartSearch->getResults().solved && _smartSearch->getResults().solutionFound;
+
+    // if we've found a solution, let us know
+    if (_smartSearch->getResults().solved && Config::Debug::DrawBuildOrderSearchInfo)
+    {
+        //BWAPI::Broodwar->printf("Build order SOLVED in %d nodes", (int)_smartSearch->getResults().nodesExpanded);
+    }
+
+    if (_smartSearch->getResults().solved)
+    {
+        if (_smartSearch->getResults().solutionFound)
+        {
+            _previousStatus = std::string("\x07") + "BOSS Solve Solution\n";
+        }
+        else
+        {
+            _previousStatus = std::string("\x03") + "BOSS Solve NoSolution\n";
+        }
+    }
+
+    // re-set all the search information to get read for the next search
+    _searchInProgress = false;
+    _previousSearchFinishFrame = BWAPI::Broodwar->getFrameCount();
+    _previousSearchResults = _smartSearch->getResults();
+    _savedSearchResults = _previousSearchResults;
+    _previousBuildOrder = _previousSearchResults.buildOrder;
+
+    if (solved && _previousBuildOrder.size() == 0)
+    {
+        _previousStatus = std::string("\x07") + "BOSS Trivial Solve\n";
+    }
+
+    // if our search resulted in a build order of size 0 then something failed
+    if (!solved && _previousBuildOrder.size() == 0)
+    {
+        // log the debug information since this shouldn't happen if everything goes to plan
+        /*std::stringstream ss;
+        ss << _smartSearch->getParameters().toString() << "\n";
+        ss << "searchTimeOut: " << (searchTimeOut ? "true" : "false") << "\n";
+        ss << "caughtException: " << (caughtException ? "true" : "false") << "\n";
+        ss << "getResults().solved: " << (_smartSearch->getResults().solved ? "true" : "false") << "\n";
+        ss << "getResults().solutionFound: " << (_smartSearch->getResults().solutionFound ? "true" : "false") << "\n";
+        ss << "nodes: " << _savedSearchResults.nodesExpanded << "\n";
+        ss << "time: " << _savedSearchResults.timeElapsed << "\n";
+        Logger::LogOverwriteToFile("bwapi-data/AI/LastBadBuildOrder.txt", ss.str());*/
+        
+        // so try another naive build order search as a last resort
+        BOSS::NaiveBuildOrderSearch nbos(_smartSearch->getParameters().initialState, _smartSearch->getParameters().goal);
+
+		try
+        {
+            if (searchTimeOut)
             {
-                if (_smartSearch->getResults().solutionFound)
-                {
-                    _previousStatus = std::string("\x07") + "BOSS Solve Solution\n";
-                }
-                else
-                {
-                    _previousStatus = std::string("\x03") + "BOSS Solve NoSolution\n";
-                }
+                _previousStatus = std::string("\x02") + "BOSS Timeout\n";
             }
 
-            // re-set all the search information to get read for the next search
-            _searchInProgress = false;
-            _previousSearchFinishFrame = BWAPI::Broodwar->getFrameCount();
-            _previousSearchResults = _smartSearch->getResults();
-            _savedSearchResults = _previousSearchResults;
-            _previousBuildOrder = _previousSearchResults.buildOrder;
-
-            if (solved && _previousBuildOrder.size() == 0)
+            if (caughtException)
             {
-                _previousStatus = std::string("\x07") + "BOSS Trivial Solve\n";
+                _previousStatus = std::string("\x02") + "BOSS Exception\n";
             }
 
-            // if our search resulted in a build order of size 0 then something failed
-            if (!solved && _previousBuildOrder.size() == 0)
+			_previousBuildOrder = nbos.solve();
+            _previousStatus += "\x03NBOS Solution";
+
+			return;
+		}
+        // and if that search doesn't work then we're out of luck, no build orders forus
+		catch (const BOSS::BOSSException & exception)
+        {
+            UAB_ASSERT_WARNING(false, "BOSS Timeout Naive Search Exception: %s", exception.what());
+            _previousStatus += "\x08Naive Exception";
+            if (Config::Debug::DrawBuildOrderSearchInfo)
             {
-                // log the debug information since this shouldn't happen if everything goes to plan
-                /*std::stringstream ss;
-                ss << _smartSearch->getParameters().toString() << "\n";
-                ss << "searchTimeOut: " << (searchTimeOut ? "true" : "false") << "\n";
-                ss << "caughtException: " << (caughtException ? "true" : "false") << "\n";
-                ss << "getResults().solved: " << (_smartSearch->getResults().solved ? "true" : "false") << "\n";
-                ss << "getResults().solutionFound: " << (_smartSearch->getResults().solutionFound ? "true" : "false") << "\n";
-                ss << "nodes: " << _savedSearchResults.nodesExpanded << "\n";
-                ss << "time: " << _savedSearchResults.timeElapsed << "\n";
-                Logger::LogOverwriteToFile("bwapi-data/AI/LastBadBuildOrder.txt", ss.str());*/
-                
-                // so try another naive build order search as a last resort
-                BOSS::NaiveBuildOrderSearch nbos(_smartSearch->getParameters().initialState, _smartSearch->getParameters().goal);
-
-				try
-                {
-                    if (searchTimeOut)
-                    {
-                        _previousStatus = std::string("\x02") + "BOSS Timeout\n";
-                    }
-
-                    if (caughtException)
-                    {
-                        _previousStatus = std::string("\x02") + "BOSS Exception\n";
-                    }
-
-					_previousBuildOrder = nbos.solve();
-                    _previousStatus += "\x03NBOS Solution";
-
-					return;
-				}
-                // and if that search doesn't work then we're out of luck, no build orders forus
-				catch (const BOSS::BOSSException & exception)
-                {
-                    UAB_ASSERT_WARNING(false, "BOSS Timeout Naive Search Exception: %s", exception.what());
-                    _previousStatus += "\x08Naive Exception";
-                    if (Config::Debug::DrawBuildOrderSearchInfo)
-                    {
-					    BWAPI::Broodwar->drawTextScreen(0, 20, "No legal BuildOrder found, returning empty Build Order");
-                    }
-					_previousBuildOrder = BOSS::BuildOrder();
-					return;
-				}
+			    BWAPI::Broodwar->drawTextScreen(0, 20, "No legal BuildOrder found, returning empty Build Order");
             }
-        }
+			_previousBuildOrder = BOSS::BuildOrder();
+			return;
+		}
     }
 }
 
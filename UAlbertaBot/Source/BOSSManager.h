@@ -5,12 +5,41 @@
 #include "../../BOSS/source/BOSS.h"
 #include "StrategyManager.h"
 #include <memory>
+#include <thread>
+#include <atomic>
 
 namespace UAlbertaBot
 {
     
 typedef std::shared_ptr<BOSS::DFBB_BuildOrderSmartSearch> SearchPtr;
 
+// what a search running on the background thread shares with the main thread
+// the search thread owns everything here until it sets finished, and never touches any of it afterwards,
+// so the main thread reads the results without a lock once it sees finished. setting cancelled makes the
+// search thread stop at the end of its current time slice, keeping the best build order found so far
+class BOSSBackgroundSearch
+{
+public:
+
+    SearchPtr                               search;
+    std::atomic<bool>                       cancelled;
+    std::atomic<bool>                       finished;
+    bool                                    caughtException;
+    std::string                             exceptionMessage;
+    double                                  searchTime;
+
+    BOSSBackgroundSearch(SearchPtr s)
+        : search(s)
+        , cancelled(false)
+        , finished(false)
+        , caughtException(false)
+        , searchTime(0)
+    {
+    }
+};
+
+typedef std::shared_ptr<BOSSBackgroundSearch> BackgroundSearchPtr;
+
 class BOSSManager
 {
     int                                     _previousSearchStartFrame;
@@ -22,6 +51,8 @@ class BOSSManager
     std::string                             _previousStatus;
 
     SearchPtr                               _smartSearch;
+    BackgroundSearchPtr                     _backgroundSearch;
+    std::thread                             _searchThread;             // joined by cancelSearch, which onEnd calls before the singleton is destroyed
 
     BOSS::DFBB_BuildOrderSearchResults      _previousSearchResults;
     BOSS::DFBB_BuildOrderSearchResults      _savedSearchResults;
@@ -39,6 +70,10 @@ class BOSSManager
     const BOSS::RaceID                      getRace() const;
 
     void                                    logBadSearch();
+    void                                    updateBackgroundSearch();
+    void                                    finishSearch(bool searchTimeOut, bool caughtException);
+
+    static void                             RunBackgroundSearch(BackgroundSearchPtr backgroundSearch);
 
 	BOSSManager();
 
@@ -48,6 +83,7 @@ public:
 
 	void						update(double timeLimit);
     void                        reset();
+    void                        cancelSearch();
 
     BuildOrder                  getBuildOrder();
     bool                        isSearchInProgress();
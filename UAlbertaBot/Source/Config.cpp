@@ -106,6 +106,7 @@ namespace Config
     namespace Macro
     {
         int BOSSFrameLimit                  = 160;
+        bool BOSSSearchInBackground         = false;    // run build order searches on their own thread instead of a slice of each frame
         int WorkersPerRefinery              = 3;
         int BuildingSpacing                 = 1;
         int PylonSpacing                    = 3;
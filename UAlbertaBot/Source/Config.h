@@ -101,6 +101,7 @@ namespace Config
     namespace Macro
     {
         extern int BOSSFrameLimit;
+        extern bool BOSSSearchInBackground;
         extern int WorkersPerRefinery;
         extern int BuildingSpacing;
         extern int PylonSpacing;
@@ -124,6 +124,8 @@ void ProductionManager::onUnitDestroy(BWAPI::Unit unit)
 		{
 			if (unit->getType() != BWAPI::UnitTypes::Zerg_Drone)
 			{
+				// a background search was started from a state we no longer have, so replace it with a new one
+				BOSSManager::Instance().cancelSearch();
 				performBuildOrderSearch();
 			}
 		}
@@ -69,6 +69,7 @@ void UAlbertaBotModule::onEnd(bool isWinner)
 	if (Config::Modules::UsingGameCommander)
 	{
 		StrategyManager::Instance().onEnd(isWinner);
+        BOSSManager::Instance().cancelSearch();
 	}	
 }
 